@@ -8,6 +8,8 @@
 #include <tuple>
 #include <vector>
 
+#include "../Utils/FastInput.h"
+
 using namespace std;
 
 tuple<int, size_t, size_t> maximumSubarray(const vector<int> &values)
@@ -37,14 +39,19 @@ tuple<int, size_t, size_t> maximumSubarray(const vector<int> &values)
 
 int main()
 {
-    size_t size;
-    cout << "Enter the input size : ";
-    cin >> size;
+    BufferedReader &input = standardInput();
+
+    size_t size = 0;
+    prompt("Enter the input size : ");
+    input.read(size);
+    if (size == 0) {
+        cout << "No values to look at.\n";
+        return 0;
+    }
 
     vector<int> values(size);
-    cout << "Enter " << size << " integers :\n";
-    for (int &val : values)
-        cin >> val;
+    prompt("Enter " + to_string(size) + " integers :\n");
+    input.read_all(values.data(), values.size());
 
     int maxSum;
     size_t start, end;
@@ -0,0 +1,245 @@
+/*
+    Arbitrary-precision (non-negative) integers:
+    Numbers are stored as vectors of 32-bit limbs, least significant limb
+    first, and multiplied with the Karatsuba algorithm once both operands are
+    long enough for it to beat schoolbook multiplication. The same limb
+    arithmetic also works in base 10^9, which is used to convert to decimal
+    by divide and conquer, instead of dividing by 10 over and over.
+
+    Time complexity:
+    O(n) for addition and subtraction, O(n^1.585) for multiplication, and
+    O(n^1.585 * log(n)) for conversion to decimal, where n is the number of
+    limbs
+
+    Space complexity:
+    O(n), where n is the number of limbs
+*/
+
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef unsigned long long int ULL;
+typedef vector<uint32_t> Limbs;
+
+const size_t KARATSUBA_THRESHOLD = 32;      // limbs, below which schoolbook multiplication is faster
+
+// limb arithmetic in the given base (which is at most 2^32)
+template <ULL BASE>
+class LimbArithmetic {
+private:
+    static Limbs slice(const Limbs &limbs, const size_t start, const size_t end) {
+        Limbs part(limbs.begin() + min(start, limbs.size()), limbs.begin() + min(end, limbs.size()));
+        trim(part);
+        return part;
+    }
+
+    static Limbs multiply_schoolbook(const Limbs &a, const Limbs &b) {
+        Limbs product(a.size() + b.size(), 0);
+        for (size_t i = 0; i < a.size(); i++) {
+            ULL carry = 0;
+            for (size_t j = 0; j < b.size(); j++) {
+                const ULL current = product[i + j] + (ULL) a[i] * b[j] + carry;
+                product[i + j] = current % BASE;
+                carry = current / BASE;
+            }
+            product[i + b.size()] = carry;
+        }
+        trim(product);
+        return product;
+    }
+
+public:
+    // removes the leading zero limbs, so that zero has no limbs at all
+    static void trim(Limbs &limbs) {
+        while (!limbs.empty() and limbs.back() == 0)
+            limbs.pop_back();
+    }
+
+    static Limbs add(const Limbs &a, const Limbs &b) {
+        Limbs sum(a);
+        add_shifted(sum, b, 0);
+        return sum;
+    }
+
+    // a += b * BASE^shift
+    static void add_shifted(Limbs &a, const Limbs &b, const size_t shift) {
+        if (b.empty())
+            return;
+        if (a.size() < b.size() + shift)
+            a.resize(b.size() + shift, 0);
+
+        ULL carry = 0;
+        size_t i = shift;
+        for (size_t j = 0; j < b.size(); i++, j++) {
+            const ULL current = (ULL) a[i] + b[j] + carry;
+            a[i] = current % BASE;
+            carry = current / BASE;
+        }
+        for (; carry != 0 and i < a.size(); i++) {
+            const ULL current = a[i] + carry;
+            a[i] = current % BASE;
+            carry = current / BASE;
+        }
+        if (carry != 0)
+            a.push_back(carry);
+    }
+
+    // a -= b, where a must not be less than b
+    static void subtract(Limbs &a, const Limbs &b) {
+        long long borrow = 0;
+        for (size_t i = 0; i < a.size() and (i < b.size() or borrow != 0); i++) {
+            long long current = (long long) a[i] - borrow - (i < b.size() ? b[i] : 0);
+            borrow = 0;
+            if (current < 0) {
+                current += BASE;
+                borrow = 1;
+            }
+            a[i] = current;
+        }
+        trim(a);
+    }
+
+    // a * small, where small is less than BASE
+    static Limbs multiply_small(const Limbs &a, const ULL small) {
+        Limbs product(a.size() + 1, 0);
+        ULL carry = 0;
+        for (size_t i = 0; i < a.size(); i++) {
+            const ULL current = (ULL) a[i] * small + carry;
+            product[i] = current % BASE;
+            carry = current / BASE;
+        }
+        product[a.size()] = carry;
+        trim(product);
+        return product;
+    }
+
+    // Karatsuba multiplication
+    static Limbs multiply(const Limbs &a, const Limbs &b) {
+        if (a.size() < b.size())
+            return multiply(b, a);
+        if (b.size() < KARATSUBA_THRESHOLD)
+            return multiply_schoolbook(a, b);
+
+        // a = a1 * BASE^half + a0, and b similarly
+        const size_t half = a.size() / 2;
+        const Limbs a0 = slice(a, 0, half);
+        const Limbs a1 = slice(a, half, a.size());
+
+        if (b.size() <= half) {     // b is much shorter, multiply it with each half of a
+            Limbs product = multiply(a0, b);
+            add_shifted(product, multiply(a1, b), half);
+            return product;
+        }
+
+        const Limbs b0 = slice(b, 0, half);
+        const Limbs b1 = slice(b, half, b.size());
+
+        const Limbs lowProduct = multiply(a0, b0);
+        const Limbs highProduct = multiply(a1, b1);
+
+        // (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1 = a0 * b1 + a1 * b0
+        Limbs middleProduct = multiply(add(a0, a1), add(b0, b1));
+        subtract(middleProduct, lowProduct);
+        subtract(middleProduct, highProduct);
+
+        Limbs product(lowProduct);
+        add_shifted(product, middleProduct, half);
+        add_shifted(product, highProduct, 2 * half);
+        return product;
+    }
+};
+
+typedef LimbArithmetic<1ULL << 32> BinaryLimbs;
+typedef LimbArithmetic<1000000000ULL> DecimalLimbs;    // 9 decimal digits per limb
+
+class BigInteger {
+private:
+    Limbs limbs;    // base 2^32, least significant first
+
+    // decimal (base 10^9) limbs of 2^(32 * 2^k), for each k
+    static const Limbs &decimal_power_of_two(const size_t k) {
+        static vector<Limbs> powers;
+        if (powers.empty())
+            powers.push_back(Limbs{ 294967296, 4 });    // 2^32 = 4 294967296
+        while (powers.size() <= k)
+            powers.push_back(DecimalLimbs::multiply(powers.back(), powers.back()));
+        return powers[k];
+    }
+
+    // decimal (base 10^9) limbs of the value of limbs[start, end)
+    Limbs to_decimal(const size_t start, const size_t end) const {
+        if (end - start <= 16) {    // short enough for Horner's method
+            Limbs decimal;
+            for (size_t i = end; i-- > start; ) {
+                decimal = DecimalLimbs::multiply_small(decimal, 65536);
+                decimal = DecimalLimbs::multiply_small(decimal, 65536);
+                DecimalLimbs::add_shifted(decimal, Limbs{ limbs[i] % 1000000000, limbs[i] / 1000000000 }, 0);
+                DecimalLimbs::trim(decimal);
+            }
+            return decimal;
+        }
+
+        // split off the lower 2^k limbs, the largest power of 2 that is less than the length
+        size_t k = 0;
+        while ((size_t(2) << k) < end - start)
+            k++;
+        const size_t half = size_t(1) << k;
+
+        Limbs decimal = DecimalLimbs::multiply(to_decimal(start + half, end), decimal_power_of_two(k));
+        DecimalLimbs::add_shifted(decimal, to_decimal(start, start + half), 0);
+        return decimal;
+    }
+
+public:
+    BigInteger(const ULL value = 0) : limbs{ uint32_t(value), uint32_t(value >> 32) } {
+        BinaryLimbs::trim(limbs);
+    }
+
+    bool is_zero() const { return limbs.empty(); }
+
+    friend BigInteger operator+(const BigInteger &a, const BigInteger &b) {
+        BigInteger sum(a);
+        BinaryLimbs::add_shifted(sum.limbs, b.limbs, 0);
+        return sum;
+    }
+
+    // a - b, where a must not be less than b
+    friend BigInteger operator-(const BigInteger &a, const BigInteger &b) {
+        BigInteger difference(a);
+        BinaryLimbs::subtract(difference.limbs, b.limbs);
+        return difference;
+    }
+
+    friend BigInteger operator*(const BigInteger &a, const BigInteger &b) {
+        BigInteger product;
+        product.limbs = BinaryLimbs::multiply(a.limbs, b.limbs);
+        return product;
+    }
+
+    friend bool operator==(const BigInteger &a, const BigInteger &b) { return a.limbs == b.limbs; }
+    friend bool operator!=(const BigInteger &a, const BigInteger &b) { return a.limbs != b.limbs; }
+
+    string to_string() const {
+        if (is_zero())
+            return "0";
+
+        const Limbs decimal = to_decimal(0, limbs.size());
+
+        string text = std::to_string(decimal.back());
+        for (size_t i = decimal.size() - 1; i-- > 0; ) {
+            const string digits = std::to_string(decimal[i]);
+            text.append(9 - digits.size(), '0');    // all but the leading limb have exactly 9 digits
+            text += digits;
+        }
+        return text;
+    }
+};
+
+#endif
@@ -1,57 +1,59 @@
 /*
     Fibonacci number:
-    Find the N-th Fibonacci number, given the value of N.
+    Find the N-th Fibonacci number, given the value of N, either exactly or
+    modulo a given number.
     (The Fibonacci sequence is characterized by the fact that every number
     after the first two is the sum of the two preceding ones.)
 
     Time complexity:
-    O(N), where N is the term of the Fibonacci sequence to calculate
+    O(log(N)) modulo a number, and O(N^1.585) exactly (see Fibonacci.h),
+    where N is the term of the Fibonacci sequence to calculate
 
     Space complexity:
-    O(1), constant amount of extra space
+    O(1) modulo a number, and O(N) exactly, where N is the term of the
+    Fibonacci sequence to calculate
 */
 
 #include <iostream>
 
-using namespace std;
-
-typedef unsigned long long int ULL;
-
-const int MAX_N = 93;   // fibonacci(94) goes beyond the range of ULL
-
-ULL fibonacci(const int n) {
-    ULL previousToPrevious = 0;     // first term, or F(n-2) in general
-    ULL previous = 1;   // second term, or F(n-1) in general
-    ULL fibo;   // F(n)
+#include "Fibonacci.h"
 
-    if (n == 0 or n == 1)
-        return n;   // since F(0) = 0, and F(1) = 1
-
-    for (int term = 2; term <= n; term++) {
-        fibo = previous + previousToPrevious;   // F(n) = F(n-1) + F(n-2)
+using namespace std;
 
-        previousToPrevious = previous;  // F(n-1) becomes F(n-2) in the next step
-        previous = fibo;    // F(n) becomes F(n-1) in the next step
-    }
+const ULL MAX_EXACT_N = 10000000;   // F(10^7) has about 2 million digits
 
-    return fibo;
+void getModulus(ULL &modulus) {
+    cout << "Enter the modulus (0 for the exact value) : ";
+    cin >> modulus;
 }
 
-void getInput(int &n) {
-    cout << "Enter the value for N (max. " << MAX_N << ") : ";
+void getInput(ULL &n, const ULL modulus) {
+    cout << "Enter the value for N";
+    if (modulus == 0)
+        cout << " (max. " << MAX_EXACT_N << ")";
+    cout << " : ";
     cin >> n;
 
-    if (n < 0 or n > MAX_N) {
-        cout << "Invalid value! N should be between 0 and " << MAX_N << ".\n";
-        getInput(n);
+    if (modulus == 0 and n > MAX_EXACT_N) {
+        cout << "Invalid value! N should be between 0 and " << MAX_EXACT_N << ".\n";
+        getInput(n, modulus);
     }
 }
 
 int main() {
-    int n;
-    getInput(n);
-
-    cout << "\nFibonacci(" << n << ") = " << fibonacci(n) << "\n";
+    ULL modulus;
+    getModulus(modulus);
+
+    ULL n;
+    getInput(n, modulus);
+
+    cout << "\nFibonacci(" << n << ")";
+    if (modulus != 0)
+        cout << " mod " << modulus << " = " << fibonacciMod(n, modulus) << "\n";
+    else if (n <= MAX_N)
+        cout << " = " << fibonacci(n) << "\n";
+    else
+        cout << " = " << fibonacciExact(n).to_string() << "\n";
 
     return 0;
 }
@@ -0,0 +1,123 @@
+/*
+    Fibonacci numbers:
+    The N-th Fibonacci number, computed either with the O(N) loop (which fits
+    in an unsigned long long only upto N = 93), or with the fast doubling
+    identities
+        F(2k)     = F(k) * (2 * F(k+1) - F(k))
+        F(2k + 1) = F(k)^2 + F(k+1)^2
+    which go from F(k) to F(2k) or F(2k + 1) in a constant number of
+    multiplications, either modulo M or exactly with big integers.
+
+    Time complexity:
+    O(N) for fibonacci, O(log(N)) for fibonacciMod, and O(M(N)) for
+    fibonacciExact, where M(N) is the time to multiply two N-bit integers
+    (O(N^1.585) with Karatsuba)
+
+    Space complexity:
+    O(1) for fibonacci and fibonacciMod, and O(N) bits for fibonacciExact
+*/
+
+#ifndef FIBONACCI_H
+#define FIBONACCI_H
+
+#include "BigInteger.h"
+
+using namespace std;
+
+const int MAX_N = 93;   // fibonacci(94) goes beyond the range of ULL
+
+ULL fibonacci(const int n) {
+    ULL previousToPrevious = 0;     // first term, or F(n-2) in general
+    ULL previous = 1;   // second term, or F(n-1) in general
+    ULL fibo = n;   // F(n), since F(0) = 0, and F(1) = 1
+
+    for (int term = 2; term <= n; term++) {
+        fibo = previous + previousToPrevious;   // F(n) = F(n-1) + F(n-2)
+
+        previousToPrevious = previous;  // F(n-1) becomes F(n-2) in the next step
+        previous = fibo;    // F(n) becomes F(n-1) in the next step
+    }
+
+    return fibo;
+}
+
+// (a + b) mod m, for a, b < m, without overflowing
+ULL addMod(const ULL a, const ULL b, const ULL modulus) {
+    return a >= modulus - b ? a - (modulus - b) : a + b;
+}
+
+// (a - b) mod m, for a, b < m
+ULL subtractMod(const ULL a, const ULL b, const ULL modulus) {
+    return a >= b ? a - b : a + (modulus - b);
+}
+
+// (a * b) mod m, for a, b < m, without overflowing
+ULL multiplyMod(ULL a, ULL b, const ULL modulus) {
+    if (modulus <= 0xFFFFFFFFULL)   // the product fits in 64 bits
+        return a * b % modulus;
+
+#if defined(__SIZEOF_INT128__)
+    return (unsigned __int128) a * b % modulus;
+#else
+    ULL product = 0;    // double and add, one bit of b at a time
+    for (; b != 0; b >>= 1) {
+        if (b & 1)
+            product = addMod(product, a, modulus);
+        a = addMod(a, a, modulus);
+    }
+    return product;
+#endif
+}
+
+// F(n) mod m, for any modulus m > 0
+ULL fibonacciMod(const ULL n, const ULL modulus) {
+    ULL fibo = 0;       // F(k), starting with k = 0
+    ULL next = 1 % modulus;     // F(k+1)
+
+    int highestBit = 63;
+    while (highestBit >= 0 and ((n >> highestBit) & 1) == 0)
+        highestBit--;
+
+    // go through the bits of n from the highest, doubling k at each bit and adding 1 if the bit is set
+    for (int bit = highestBit; bit >= 0; bit--) {
+        const ULL doubled = multiplyMod(fibo, subtractMod(addMod(next, next, modulus), fibo, modulus), modulus);
+        const ULL doubledNext = addMod(multiplyMod(fibo, fibo, modulus), multiplyMod(next, next, modulus), modulus);
+
+        if ((n >> bit) & 1) {
+            fibo = doubledNext;
+            next = addMod(doubled, doubledNext, modulus);
+        } else {
+            fibo = doubled;
+            next = doubledNext;
+        }
+    }
+
+    return fibo;
+}
+
+// F(n), exactly
+BigInteger fibonacciExact(const ULL n) {
+    BigInteger fibo = 0;    // F(k), starting with k = 0
+    BigInteger next = 1;    // F(k+1)
+
+    int highestBit = 63;
+    while (highestBit >= 0 and ((n >> highestBit) & 1) == 0)
+        highestBit--;
+
+    for (int bit = highestBit; bit >= 0; bit--) {
+        const BigInteger doubled = fibo * (next + next - fibo);
+        const BigInteger doubledNext = fibo * fibo + next * next;
+
+        if ((n >> bit) & 1) {
+            fibo = doubledNext;
+            next = doubled + doubledNext;
+        } else {
+            fibo = doubled;
+            next = doubledNext;
+        }
+    }
+
+    return fibo;
+}
+
+#endif
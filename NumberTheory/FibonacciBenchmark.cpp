@@ -0,0 +1,152 @@
+/*
+    Fibonacci benchmark:
+    Compares the linear fibonacci() loop with fast doubling, both for the
+    values that fit in an unsigned long long and for large N, where the
+    linear loop is extended to big integers (exactly) or to modular addition.
+    Then compares answering a batch of F(N) mod M queries one at a time with
+    the batch query engine. Checks that all of them agree.
+
+    (Compile with the -O2 flag when using the CLI.)
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Fibonacci.h"
+#include "FibonacciQueries.h"
+
+using namespace std;
+
+template <typename Function>
+double secondsToRun(Function function) {
+    const auto start = chrono::steady_clock::now();
+    function();
+    const auto end = chrono::steady_clock::now();
+
+    return chrono::duration<double>(end - start).count();
+}
+
+void printResult(const string &name, const double baselineSeconds, const double seconds, const bool isCorrect) {
+    cout << left << setw(36) << name << right << fixed << setprecision(6)
+         << setw(14) << baselineSeconds << setw(14) << seconds
+         << setw(10) << setprecision(1) << baselineSeconds / seconds << "x"
+         << (isCorrect ? "" : "   MISMATCH!") << "\n";
+}
+
+int main() {
+    bool allCorrect = true;
+
+    cout << left << setw(36) << "benchmark" << right << setw(14) << "linear (s)"
+         << setw(14) << "doubling (s)" << setw(11) << "speedup" << "\n";
+
+    // every F(n) that fits in ULL, many times over, since each one is so quick
+    const int REPEATS = 100000;
+    ULL linearChecksum = 0, doublingChecksum = 0;
+    const double linearSmallSeconds = secondsToRun([&]() {
+        for (int repeat = 0; repeat < REPEATS; repeat++)
+            for (int n = 0; n <= MAX_N; n++)
+                linearChecksum += fibonacci(n) ^ repeat;
+    });
+    const double doublingSmallSeconds = secondsToRun([&]() {
+        for (int repeat = 0; repeat < REPEATS; repeat++)
+            for (int n = 0; n <= MAX_N; n++)     // no F(n) upto 93 reaches the modulus
+                doublingChecksum += fibonacciMod(n, ~0ULL) ^ repeat;
+    });
+    allCorrect = allCorrect and linearChecksum == doublingChecksum;
+    printResult("F(0..93), " + to_string(REPEATS) + " times", linearSmallSeconds, doublingSmallSeconds,
+                linearChecksum == doublingChecksum);
+
+    // modular, with the linear loop done modulo m
+    const ULL MODULUS = 1000000007;
+    for (const ULL n : { 1000000ULL, 100000000ULL }) {
+        ULL linearFibo = 0, doublingFibo = 0;
+        const double linearSeconds = secondsToRun([&]() {
+            ULL previous = 1;
+            for (ULL term = 1; term <= n; term++) {
+                const ULL fibo = addMod(previous, linearFibo, MODULUS);
+                linearFibo = previous;
+                previous = fibo;
+            }
+        });
+        const double doublingSeconds = secondsToRun([&]() {
+            doublingFibo = fibonacciMod(n, MODULUS);
+        });
+        allCorrect = allCorrect and linearFibo == doublingFibo;
+        printResult("F(" + to_string(n) + ") mod " + to_string(MODULUS), linearSeconds, doublingSeconds,
+                    linearFibo == doublingFibo);
+    }
+
+    // exact, with the linear loop done with big integers
+    for (const ULL n : { 10000ULL, 100000ULL }) {
+        BigInteger linearFibo = 0, doublingFibo = 0;
+        const double linearSeconds = secondsToRun([&]() {
+            BigInteger previous = 1;
+            for (ULL term = 1; term <= n; term++) {
+                BigInteger fibo = previous + linearFibo;
+                linearFibo = previous;
+                previous = fibo;
+            }
+        });
+        const double doublingSeconds = secondsToRun([&]() {
+            doublingFibo = fibonacciExact(n);
+        });
+        allCorrect = allCorrect and linearFibo == doublingFibo;
+        printResult("F(" + to_string(n) + ") exactly", linearSeconds, doublingSeconds, linearFibo == doublingFibo);
+    }
+
+    // doubling alone, at sizes the linear loop can not reach
+    cout << "\n";
+    for (const ULL n : { 1000000ULL, 10000000ULL }) {
+        BigInteger fibo;
+        const double seconds = secondsToRun([&]() {
+            fibo = fibonacciExact(n);
+        });
+        cout << "F(" << n << ") exactly by doubling: " << fixed << setprecision(3) << seconds << " s\n";
+    }
+    volatile ULL hugeFibo;      // volatile, so that the call is not optimized away
+    const double hugeSeconds = secondsToRun([&]() {
+        hugeFibo = fibonacciMod(1000000000000000000ULL, MODULUS);
+    });
+    cout << "F(10^18) mod " << MODULUS << " by doubling: " << fixed << setprecision(9)
+         << hugeSeconds << " s (= " << hugeFibo << ")\n";
+
+    // batches of queries, answered one by one and by the query engine
+    cout << "\n" << left << setw(36) << "batch benchmark" << right << setw(14) << "one by one (s)"
+         << setw(14) << "engine (s)" << setw(11) << "speedup" << "\n";
+
+    const size_t QUERY_COUNT = 10000000;
+    mt19937_64 generator(2017);
+    vector<ULL> moduli;
+    for (int i = 0; i < 100; i++)
+        moduli.push_back(1 + generator() % 10000);
+
+    for (const bool isSmallN : { true, false }) {
+        vector<FibonacciQuery> queries(QUERY_COUNT);
+        for (FibonacciQuery &query : queries) {
+            query.n = isSmallN ? generator() % (MAX_N + 1) : generator() % 1000000000000000000ULL;
+            query.modulus = moduli[generator() % moduli.size()];
+        }
+
+        vector<ULL> oneByOneAnswers(QUERY_COUNT), engineAnswers;
+        const double oneByOneSeconds = secondsToRun([&]() {
+            for (size_t i = 0; i < QUERY_COUNT; i++)
+                oneByOneAnswers[i] = isSmallN ? fibonacci(queries[i].n) % queries[i].modulus
+                                              : fibonacciMod(queries[i].n, queries[i].modulus);
+        });
+        const double engineSeconds = secondsToRun([&]() {
+            FibonacciQueryEngine engine;
+            engineAnswers = engine.answer(queries);
+        });
+
+        const bool isCorrect = oneByOneAnswers == engineAnswers;
+        allCorrect = allCorrect and isCorrect;
+        printResult(isSmallN ? "10^7 queries, N <= 93, fibonacci()" : "10^7 queries, N < 10^18, doubling",
+                    oneByOneSeconds, engineSeconds, isCorrect);
+    }
+
+    return allCorrect ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/*
+    Batch Fibonacci queries:
+    Given Q queries (N, M), find F(N) mod M for each of them, grouping the
+    queries by modulus and reducing each N modulo the Pisano period of its
+    modulus (see FibonacciQueries.h).
+
+    Time complexity:
+    O(Q + D * (sqrt(M) + log^2(M))), where Q is the number of queries, and D
+    is the number of distinct moduli, each at most M
+
+    Space complexity:
+    O(Q + P), where Q is the number of queries and P is the longest Pisano
+    period that gets tabulated
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "FibonacciQueries.h"
+#include "../Utils/BufferedWriter.h"
+
+using namespace std;
+
+void getQueries(vector<FibonacciQuery> &queries) {
+    size_t queryCount;
+    cout << "Enter the number of queries : ";
+    cin >> queryCount;
+
+    queries.resize(queryCount);
+    cout << "\nEnter " << queryCount << " queries as \"N M\" (M > 0) :\n";
+    for (FibonacciQuery &query : queries) {
+        cin >> query.n >> query.modulus;
+        while (query.modulus == 0) {
+            cout << "The modulus should be positive! Enter it again : ";
+            cin >> query.modulus;
+        }
+    }
+}
+
+int main() {
+    ios_base::sync_with_stdio(false);   // don't sync C++ streams with C streams
+
+    vector<FibonacciQuery> queries;
+    getQueries(queries);
+
+    FibonacciQueryEngine engine;
+    const vector<ULL> answers = engine.answer(queries);
+
+    cout << "\nThe answers are :\n";
+    BufferedWriter output;
+    for (size_t i = 0; i < queries.size(); i++)
+        output << "Fibonacci(" << queries[i].n << ") mod " << queries[i].modulus << " = " << answers[i] << '\n';
+
+    return 0;
+}
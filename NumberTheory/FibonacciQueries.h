@@ -0,0 +1,216 @@
+/*
+    Batch Fibonacci queries:
+    Answers many (N, M) queries for F(N) mod M at once. The queries are grouped
+    by modulus, and for each modulus its Pisano period (the period with which
+    the Fibonacci sequence repeats modulo M) is found once and cached, so that
+    every N can be reduced modulo the period. Reduced indices upto 93 are
+    looked up in a compile-time table of all the Fibonacci numbers that fit in
+    an unsigned long long. When a modulus has more queries than its period, a
+    table of the whole period is built, and its queries become lookups too.
+    The rest use fast doubling on the reduced index.
+
+    The Pisano period of M = p1^k1 * p2^k2 * ... divides the lcm of
+    p^(k-1) * P(p) over its prime powers, where P(p) divides p - 1 if
+    p = +-1 (mod 10), 2 * (p + 1) if p = +-3 (mod 10), and P(2) = 3,
+    P(5) = 20. Dividing out the prime factors of that bound while it stays a
+    period gives the exact period.
+
+    Time complexity:
+    O(Q + D * (sqrt(M) + log^2(M))) for Q queries with D distinct moduli,
+    each at most M, plus O(log(M)) for each query that is neither in the
+    compile-time table nor in a period table
+
+    Space complexity:
+    O(Q + P), where P is the longest Pisano period that gets tabulated
+*/
+
+#ifndef FIBONACCI_QUERIES_H
+#define FIBONACCI_QUERIES_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Fibonacci.h"
+
+using namespace std;
+
+// F(n), computed at compile time (the values beyond F(93) wrap around)
+constexpr ULL compileTimeFibonacci(const int n, const ULL previous = 0, const ULL current = 1) {
+    return n == 0 ? previous : compileTimeFibonacci(n - 1, current, previous + current);
+}
+
+// builds { F(0), F(1), ..., F(count - 1) } at compile time
+template <int count, ULL... values>
+struct FibonacciTable : FibonacciTable<count - 1, compileTimeFibonacci(count - 1), values...> {};
+
+template <ULL... values>
+struct FibonacciTable<0, values...> {
+    static constexpr ULL value[sizeof...(values)] = { values... };
+};
+
+template <ULL... values>
+constexpr ULL FibonacciTable<0, values...>::value[sizeof...(values)];
+
+// every Fibonacci number that fits in ULL, i.e. F(0) to F(MAX_N)
+const ULL (&FIBONACCI_TABLE)[MAX_N + 1] = FibonacciTable<MAX_N + 1>::value;
+
+static_assert(FibonacciTable<MAX_N + 1>::value[MAX_N] == 12200160415121876738ULL, "F(93) is wrong");
+
+const ULL MAX_PISANO_MODULUS = 1ULL << 32;  // larger moduli are not factorized
+const ULL MAX_PERIOD_TABLE_SIZE = 1 << 22;  // longest period that gets tabulated
+
+struct FibonacciQuery {
+    ULL n;
+    ULL modulus;    // must be positive
+};
+
+// prime factorization by trial division, as (prime, exponent) pairs
+vector<pair<ULL, int>> factorize(ULL num) {
+    vector<pair<ULL, int>> factors;
+    for (ULL divisor = 2; divisor * divisor <= num; divisor++) {
+        if (num % divisor != 0)
+            continue;
+
+        int exponent = 0;
+        for (; num % divisor == 0; num /= divisor)
+            exponent++;
+        factors.push_back(make_pair(divisor, exponent));
+    }
+    if (num > 1)
+        factors.push_back(make_pair(num, 1));
+
+    return factors;
+}
+
+class FibonacciQueryEngine {
+private:
+    unordered_map<ULL, ULL> pisanoPeriods;      // cached, across batches
+
+    static bool is_period(const ULL length, const ULL modulus) {
+        return fibonacciMod(length, modulus) == 0 and fibonacciMod(length + 1, modulus) == 1 % modulus;
+    }
+
+    static ULL find_pisano_period(const ULL modulus) {
+        // a multiple of the period, along with its prime factorization (prime -> exponent)
+        ULL period = 1;
+        unordered_map<ULL, int> periodFactors;
+
+        for (const pair<ULL, int> &primePower : factorize(modulus)) {
+            const ULL prime = primePower.first;
+            ULL primeBound;
+            if (prime == 2)
+                primeBound = 3;
+            else if (prime == 5)
+                primeBound = 20;
+            else if (prime % 10 == 1 or prime % 10 == 9)
+                primeBound = prime - 1;
+            else
+                primeBound = 2 * (prime + 1);
+
+            // take the lcm with p^(k-1) * primeBound
+            unordered_map<ULL, int> boundFactors;
+            for (const pair<ULL, int> &factor : factorize(primeBound))
+                boundFactors[factor.first] += factor.second;
+            boundFactors[prime] += primePower.second - 1;
+
+            for (const pair<const ULL, int> &factor : boundFactors) {
+                int &exponent = periodFactors[factor.first];
+                for (; exponent < factor.second; exponent++)
+                    period *= factor.first;
+            }
+        }
+
+        // divide out prime factors as long as what is left is still a period
+        for (const pair<const ULL, int> &factor : periodFactors)
+            for (int exponent = 0; exponent < factor.second and is_period(period / factor.first, modulus); exponent++)
+                period /= factor.first;
+
+        return period;
+    }
+
+public:
+    // Pisano period of the modulus, or 0 if the modulus is too large to factorize quickly
+    ULL pisano_period(const ULL modulus) {
+        if (modulus > MAX_PISANO_MODULUS)
+            return 0;
+
+        const unordered_map<ULL, ULL>::const_iterator cached = pisanoPeriods.find(modulus);
+        if (cached != pisanoPeriods.end())
+            return cached->second;
+
+        const ULL period = find_pisano_period(modulus);
+        pisanoPeriods[modulus] = period;
+        return period;
+    }
+
+    // F(n) mod m for each query, in the same order as the queries
+    vector<ULL> answer(const vector<FibonacciQuery> &queries) {
+        // group the queries by modulus
+        unordered_map<ULL, size_t> groupOf;
+        vector<ULL> groupModuli;
+        vector<size_t> groupSizes;
+        vector<uint32_t> queryGroups(queries.size());
+
+        for (size_t i = 0; i < queries.size(); i++) {
+            const ULL modulus = queries[i].modulus;
+            size_t group;
+            if (i > 0 and modulus == queries[i - 1].modulus) {  // runs of the same modulus skip the lookup
+                group = queryGroups[i - 1];
+            } else {
+                const unordered_map<ULL, size_t>::const_iterator found = groupOf.find(modulus);
+                if (found != groupOf.end()) {
+                    group = found->second;
+                } else {
+                    group = groupModuli.size();
+                    groupOf[modulus] = group;
+                    groupModuli.push_back(modulus);
+                    groupSizes.push_back(0);
+                }
+            }
+            queryGroups[i] = group;
+            groupSizes[group]++;
+        }
+
+        // find the period of each modulus once, and tabulate the whole period
+        // if that is cheaper than answering its queries one by one
+        vector<ULL> groupPeriods(groupModuli.size());
+        vector<vector<uint32_t>> periodTables(groupModuli.size());
+
+        for (size_t group = 0; group < groupModuli.size(); group++) {
+            const ULL modulus = groupModuli[group];
+            const ULL period = pisano_period(modulus);
+            groupPeriods[group] = period;
+
+            if (period > MAX_N + 1 and period <= MAX_PERIOD_TABLE_SIZE and period <= groupSizes[group]) {
+                vector<uint32_t> &periodTable = periodTables[group];
+                periodTable.resize(period);
+                periodTable[0] = 0;
+                periodTable[1] = 1 % modulus;
+                for (ULL i = 2; i < period; i++)
+                    periodTable[i] = addMod(periodTable[i - 1], periodTable[i - 2], modulus);
+            }
+        }
+
+        // answer the queries in their own order, so that they are read and written sequentially
+        vector<ULL> answers(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) {
+            const size_t group = queryGroups[i];
+            const ULL modulus = queries[i].modulus;
+            const ULL period = groupPeriods[group];
+            const ULL n = period != 0 ? queries[i].n % period : queries[i].n;
+
+            if (!periodTables[group].empty())
+                answers[i] = periodTables[group][n];
+            else if (n <= (ULL) MAX_N)
+                answers[i] = FIBONACCI_TABLE[n] % modulus;
+            else
+                answers[i] = fibonacciMod(n, modulus);
+        }
+
+        return answers;
+    }
+};
+
+#endif
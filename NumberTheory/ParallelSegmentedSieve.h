@@ -0,0 +1,184 @@
+/*
+    Parallel segmented Sieve of Eratosthenes:
+    Divides the range [L, R] into blocks of consecutive segments, which are
+    claimed one at a time by a pool of worker threads. Each worker sieves its
+    blocks with the (shared, read-only) base primes, and the results are then
+    combined in increasing order, either as a count, as a bitmap, or by calling
+    back with every prime.
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O(N * log(log(N)) / T), where N is the upper limit R and T is the number
+    of threads
+
+    Space complexity:
+    O(sqrt(N) + T * S), where N is the upper limit R, T is the number of
+    threads and S is the segment size (plus the output, for the bitmap and
+    the ordered callback)
+*/
+
+#ifndef PARALLEL_SEGMENTED_SIEVE_H
+#define PARALLEL_SEGMENTED_SIEVE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "SegmentedSieve.h"
+
+using namespace std;
+
+const ULL DEFAULT_BLOCK_SIZE = 1 << 23;    // numbers per block (a multiple of 64)
+
+unsigned int defaultThreadCount() {
+    const unsigned int hardwareThreads = thread::hardware_concurrency();
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+/*
+    Runs work(blockIndex) for every block index in [firstBlock, lastBlock)
+    on threadCount threads, each of which claims the next unclaimed block
+    until there are none left.
+*/
+template <typename BlockWork>
+void runBlocksInParallel(const ULL firstBlock, const ULL lastBlock, unsigned int threadCount, BlockWork work) {
+    if (firstBlock >= lastBlock)
+        return;
+    threadCount = max(1u, (unsigned int) min<ULL>(threadCount, lastBlock - firstBlock));
+
+    atomic<ULL> nextBlock(firstBlock);
+    auto worker = [&]() {
+        for (ULL block = nextBlock++; block < lastBlock; block = nextBlock++)
+            work(block);
+    };
+
+    vector<thread> workers;
+    for (unsigned int t = 1; t < threadCount; t++)
+        workers.emplace_back(worker);
+    worker();   // the calling thread works too
+
+    for (thread &workerThread : workers)
+        workerThread.join();
+}
+
+// blockSize rounded up to a multiple of 64 (at least 64), so that every block starts on a bitmap word
+ULL wordAlignedBlockSize(const ULL blockSize) {
+    const ULL maxBlockSize = ~0ULL / 64 * 64;
+    if (blockSize > maxBlockSize)
+        return maxBlockSize;
+    return max<ULL>((blockSize + 63) / 64 * 64, 64);
+}
+
+ULL blockCountOf(const ULL low, const ULL high, const ULL blockSize) {
+    return (high - low) / blockSize + 1;
+}
+
+// sieves the blockIndex-th block of [low, high], calling handleSegment as segmentedSieve does
+template <typename SegmentHandler>
+void sieveBlock(const ULL low, const ULL high, const ULL blockIndex, const ULL blockSize,
+                const vector<unsigned int> &primes, SegmentHandler handleSegment) {
+    const ULL blockStart = low + blockIndex * blockSize;
+    // (blockStart + blockSize - 1 can overflow, near the top of the range)
+    const ULL blockEnd = high - blockStart < blockSize - 1 ? high : blockStart + (blockSize - 1);
+    segmentedSieve(blockStart, blockEnd, primes, handleSegment);
+}
+
+// number of primes in [low, high]
+ULL parallelCountPrimes(const ULL low, const ULL high, const unsigned int threadCount = defaultThreadCount(),
+                        ULL blockSize = DEFAULT_BLOCK_SIZE) {
+    if (low > high)
+        return 0;
+    blockSize = wordAlignedBlockSize(blockSize);
+
+    const vector<unsigned int> primes = basePrimes(high);
+    const ULL blockCount = blockCountOf(low, high, blockSize);
+    vector<ULL> blockPrimeCounts(blockCount, 0);
+
+    runBlocksInParallel(0, blockCount, threadCount, [&](const ULL block) {
+        ULL primeCount = 0;
+        sieveBlock(low, high, block, blockSize, primes,
+            [&primeCount](const ULL, const vector<char> &isPrime, const size_t segmentLength) {
+                primeCount += count(isPrime.begin(), isPrime.begin() + segmentLength, 1);
+            });
+        blockPrimeCounts[block] = primeCount;
+    });
+
+    ULL primeCount = 0;
+    for (const ULL &blockPrimeCount : blockPrimeCounts)
+        primeCount += blockPrimeCount;
+
+    return primeCount;
+}
+
+/*
+    Bitmap of the primes in [low, high]: bit (i % 64) of word (i / 64) is set
+    if (low + i) is prime. The block size is rounded up to a multiple of 64,
+    so every block starts on a word boundary, and no two threads ever write
+    to the same word.
+*/
+vector<uint64_t> parallelSieveBitmap(const ULL low, const ULL high, const unsigned int threadCount = defaultThreadCount(),
+                                     ULL blockSize = DEFAULT_BLOCK_SIZE) {
+    if (low > high)
+        return vector<uint64_t>();
+    blockSize = wordAlignedBlockSize(blockSize);
+
+    const vector<unsigned int> primes = basePrimes(high);
+    const ULL blockCount = blockCountOf(low, high, blockSize);
+    vector<uint64_t> bitmap((high - low) / 64 + 1, 0);
+
+    runBlocksInParallel(0, blockCount, threadCount, [&](const ULL block) {
+        sieveBlock(low, high, block, blockSize, primes,
+            [&](const ULL segmentStart, const vector<char> &isPrime, const size_t segmentLength) {
+                const ULL offset = segmentStart - low;
+                for (size_t i = 0; i < segmentLength; i++)
+                    if (isPrime[i])
+                        bitmap[(offset + i) / 64] |= uint64_t(1) << ((offset + i) % 64);
+            });
+    });
+
+    return bitmap;
+}
+
+/*
+    Calls handlePrime(prime) for every prime in [low, high], in increasing
+    order, from the calling thread. The blocks are sieved threadCount at a
+    time, and the primes of each round are handed over before the next round
+    starts, which keeps the memory bounded.
+*/
+template <typename PrimeHandler>
+void parallelForEachPrime(const ULL low, const ULL high, PrimeHandler handlePrime,
+                          unsigned int threadCount = defaultThreadCount(),
+                          ULL blockSize = DEFAULT_BLOCK_SIZE) {
+    if (low > high)
+        return;
+    threadCount = max(1u, threadCount);
+    blockSize = wordAlignedBlockSize(blockSize);
+
+    const vector<unsigned int> primes = basePrimes(high);
+    const ULL blockCount = blockCountOf(low, high, blockSize);
+    vector<vector<ULL>> roundPrimes(threadCount);
+
+    for (ULL roundStart = 0; roundStart < blockCount; roundStart += threadCount) {
+        const ULL roundEnd = min(blockCount, roundStart + threadCount);
+
+        runBlocksInParallel(roundStart, roundEnd, threadCount, [&](const ULL block) {
+            vector<ULL> &blockPrimes = roundPrimes[block - roundStart];
+            blockPrimes.clear();
+            sieveBlock(low, high, block, blockSize, primes,
+                [&blockPrimes](const ULL segmentStart, const vector<char> &isPrime, const size_t segmentLength) {
+                    for (size_t i = 0; i < segmentLength; i++)
+                        if (isPrime[i])
+                            blockPrimes.push_back(segmentStart + i);
+                });
+        });
+
+        for (ULL block = roundStart; block < roundEnd; block++)
+            for (const ULL &prime : roundPrimes[block - roundStart])
+                handlePrime(prime);
+    }
+}
+
+#endif
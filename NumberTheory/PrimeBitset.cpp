@@ -0,0 +1,48 @@
+/*
+    Prime numbers in a wheel-factorized bitset:
+    Given a number N, store all prime numbers upto N (inclusive) in a packed
+    mod-30 wheel bitset (see PrimeBitset.h), and then answer whether numbers
+    are prime and how many primes there are in a range.
+
+    Time complexity:
+    O(N * log(log(N))) to build the bitset, O(1) to check whether a number is
+    prime, and O((R - L) / 240) to count the primes in a range [L, R]
+
+    Space complexity:
+    O(N / 30) bytes, where N is the number upto which primes have to be found
+*/
+
+#include <iostream>
+#include <string>
+
+#include "PrimeBitset.h"
+
+using namespace std;
+
+void getPrimeLimit(ULL &primeLimit) {
+    cout << "Enter the number upto which primes are to be found : ";
+    cin >> primeLimit;
+}
+
+int main() {
+    ios_base::sync_with_stdio(false);   // don't sync C++ streams with C streams
+
+    ULL primeLimit;
+    getPrimeLimit(primeLimit);
+
+    const PrimeBitset primes(primeLimit);
+    cout << "\nThere are " << primes.count(0, primeLimit) << " prime numbers upto "
+         << primeLimit << " (inclusive), stored in " << primes.data().size() * 8 << " bytes\n";
+
+    ULL low, high;
+    cout << "\nEnter ranges [L, R] to count primes in (L = R to check whether L is prime) :\n";
+    while (cin >> low >> high) {
+        if (low == high)
+            cout << low << (primes.is_prime(low) ? " is prime\n" : " is not prime\n");
+        else
+            cout << "There are " << primes.count(low, high) << " prime numbers between "
+                 << low << " and " << high << " (inclusive)\n";
+    }
+
+    return 0;
+}
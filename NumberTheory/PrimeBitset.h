@@ -0,0 +1,238 @@
+/*
+    Wheel-factorized prime bitset:
+    A compact set of all primes upto N, which only stores the numbers that are
+    coprime to 2 * 3 * 5 = 30 (a mod-30 wheel). Each block of 30 consecutive
+    numbers has exactly 8 such numbers (with residues 1, 7, 11, 13, 17, 19, 23
+    and 29), so it takes 8 bits, instead of the 30 that a vector<bool> of
+    every number takes. The bits are packed into 64-bit words, so counting
+    primes is a popcount per word, and iterating over them is a find-next-set
+    bit per prime.
+
+    Time complexity:
+    O(N * log(log(N))) to build (with the segmented sieve), O(1) for is_prime,
+    O((R - L) / 240) for count(L, R), and O(gap / 240) to get the next prime,
+    where N is the number upto which primes are stored
+
+    Space complexity:
+    O(N / 30) bytes, where N is the number upto which primes are stored
+*/
+
+#ifndef PRIME_BITSET_H
+#define PRIME_BITSET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "SegmentedSieve.h"
+
+using namespace std;
+
+const ULL WHEEL_MODULUS = 30;
+const int WHEEL_SPOKES = 8;     // numbers coprime to WHEEL_MODULUS in each turn of the wheel
+
+// numbers coprime to 30, in each turn of the wheel
+const ULL WHEEL_RESIDUES[WHEEL_SPOKES] = { 1, 7, 11, 13, 17, 19, 23, 29 };
+
+// bit of each residue mod 30 within its turn of the wheel (-1 if not on the wheel)
+const int WHEEL_BIT[WHEEL_MODULUS] = {
+    -1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1,
+    -1, -1, 4, -1, 5, -1, -1, -1, 6, -1, -1, -1, -1, -1, 7
+};
+
+// number of wheel residues less than each residue mod 30
+const int WHEEL_RESIDUES_BELOW[WHEEL_MODULUS] = {
+    0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4,
+    4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7
+};
+
+int popcount64(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int setBits = 0;
+    for (; word != 0; word &= word - 1)
+        setBits++;
+    return setBits;
+#endif
+}
+
+// index of the lowest set bit of a non-zero word
+int countTrailingZeros64(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int zeros = 0;
+    for (; (word & 1) == 0; word >>= 1)
+        zeros++;
+    return zeros;
+#endif
+}
+
+// number of wheel numbers (those coprime to 30) less than num, i.e. the bit of num if it is on the wheel
+ULL wheelPosition(const ULL num) {
+    return num / WHEEL_MODULUS * WHEEL_SPOKES + WHEEL_RESIDUES_BELOW[num % WHEEL_MODULUS];
+}
+
+// the wheel number at the given bit
+ULL wheelNumber(const ULL bit) {
+    return bit / WHEEL_SPOKES * WHEEL_MODULUS + WHEEL_RESIDUES[bit % WHEEL_SPOKES];
+}
+
+class PrimeBitset {
+private:
+    ULL primeLimit;
+    vector<uint64_t> words;
+
+    void set_bit(const ULL bit) {
+        words[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+
+    bool test_bit(const ULL bit) const {
+        return (words[bit / 64] >> (bit % 64)) & 1;
+    }
+
+    // number of set bits in [beginBit, endBit)
+    ULL count_bits(const ULL beginBit, const ULL endBit) const {
+        if (beginBit >= endBit)
+            return 0;
+
+        const ULL firstWord = beginBit / 64;
+        const ULL lastWord = (endBit - 1) / 64;
+        const uint64_t firstMask = ~uint64_t(0) << (beginBit % 64);
+        const uint64_t lastMask = ~uint64_t(0) >> (63 - (endBit - 1) % 64);
+
+        if (firstWord == lastWord)
+            return popcount64(words[firstWord] & firstMask & lastMask);
+
+        ULL setBits = popcount64(words[firstWord] & firstMask);
+        for (ULL word = firstWord + 1; word < lastWord; word++)
+            setBits += popcount64(words[word]);
+        setBits += popcount64(words[lastWord] & lastMask);
+
+        return setBits;
+    }
+
+    // first set bit at or after the given bit, or the total number of bits if there is none
+    ULL find_next_bit(const ULL bit) const {
+        ULL word = bit / 64;
+        if (word >= words.size())
+            return words.size() * 64;
+
+        uint64_t remaining = words[word] & (~uint64_t(0) << (bit % 64));
+        while (remaining == 0) {
+            if (++word == words.size())
+                return words.size() * 64;
+            remaining = words[word];
+        }
+
+        return word * 64 + countTrailingZeros64(remaining);
+    }
+
+public:
+    // iterates over the primes in increasing order
+    class const_iterator {
+    private:
+        const PrimeBitset *primes;
+        ULL prime;      // 0 past the last prime
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ULL value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const ULL *pointer;
+        typedef ULL reference;
+
+        const_iterator(const PrimeBitset *primes, const ULL prime) : primes(primes), prime(prime) {}
+
+        ULL operator*() const { return prime; }
+
+        const_iterator &operator++() {
+            prime = primes->next_prime(prime + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator &other) const { return prime == other.prime; }
+        bool operator!=(const const_iterator &other) const { return prime != other.prime; }
+    };
+
+    // builds the set of primes upto primeLimit (inclusive) with the segmented sieve
+    explicit PrimeBitset(const ULL primeLimit)
+        : primeLimit(primeLimit), words(wheelPosition(primeLimit + 1) / 64 + 1, 0) {
+        segmentedSieve(7, primeLimit,
+            [this](const ULL segmentStart, const vector<char> &isPrime, const size_t segmentLength) {
+                for (size_t i = 0; i < segmentLength; i++)
+                    if (isPrime[i])     // every prime from 7 onwards is on the wheel
+                        set_bit(wheelPosition(segmentStart + i));
+            });
+    }
+
+    // packs the output of simpleSieve
+    explicit PrimeBitset(const vector<bool> &markedPrimes)
+        : primeLimit(markedPrimes.empty() ? 0 : markedPrimes.size() - 1),
+          words(wheelPosition(primeLimit + 1) / 64 + 1, 0) {
+        for (ULL num = 7; num <= primeLimit; num++)
+            if (markedPrimes[num])
+                set_bit(wheelPosition(num));
+    }
+
+    // rebuilds a set from its words (as written by data()), e.g. when loading from a file
+    PrimeBitset(const ULL primeLimit, const vector<uint64_t> &words)
+        : primeLimit(primeLimit), words(words) {}
+
+    ULL limit() const { return primeLimit; }
+
+    const vector<uint64_t> &data() const { return words; }
+
+    bool is_prime(const ULL num) const {
+        if (num > primeLimit)
+            return false;
+        if (num < 7)
+            return num == 2 or num == 3 or num == 5;
+
+        const int bit = WHEEL_BIT[num % WHEEL_MODULUS];
+        return bit >= 0 and test_bit(num / WHEEL_MODULUS * WHEEL_SPOKES + bit);
+    }
+
+    // number of primes in [low, high]
+    ULL count(const ULL low, ULL high) const {
+        if (high > primeLimit)
+            high = primeLimit;
+        if (low > high)
+            return 0;
+
+        ULL primeCount = 0;
+        for (const ULL smallPrime : { 2, 3, 5 })    // the primes that are not on the wheel
+            if (low <= smallPrime and smallPrime <= high)
+                primeCount++;
+
+        return primeCount + count_bits(wheelPosition(low), wheelPosition(high + 1));
+    }
+
+    // smallest prime not less than num, or 0 if there is none upto the limit
+    ULL next_prime(const ULL num) const {
+        if (num <= 5)
+            for (const ULL smallPrime : { 2, 3, 5 })
+                if (num <= smallPrime)
+                    return smallPrime <= primeLimit ? smallPrime : 0;
+
+        const ULL bit = find_next_bit(wheelPosition(num));
+        if (bit == words.size() * 64)
+            return 0;
+
+        const ULL prime = wheelNumber(bit);
+        return prime <= primeLimit ? prime : 0;
+    }
+
+    const_iterator begin() const { return const_iterator(this, next_prime(0)); }
+    const_iterator end() const { return const_iterator(this, 0); }
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+    Precomputed prime table:
+    Build a prime table file for all primes upto N once (see PrimeTable.h), and
+    then memory-map it to answer is_prime(x), pi(x) (the number of primes upto
+    x) and nth_prime(n) queries without sieving again.
+
+    Time complexity:
+    O(N * log(log(N))) to build the table, O(1) to open it, and O(1) to
+    O(log(N)) per query, where N is the number upto which primes are stored
+
+    Space complexity:
+    O(N / 30) bytes, where N is the number upto which primes are stored
+*/
+
+#include <iostream>
+#include <string>
+
+#include "PrimeTable.h"
+
+using namespace std;
+
+void getFileName(string &fileName) {
+    cout << "Enter the name of the prime table file : ";
+    getline(cin, fileName);
+}
+
+void buildTable(const string &fileName) {
+    ULL primeLimit;
+    cout << "No valid table found there. Enter the number upto which primes are to be stored : ";
+    cin >> primeLimit;
+
+    if (!writePrimeTable(PrimeBitset(primeLimit), fileName))
+        cout << "Could not write the table to " << fileName << "!\n";
+}
+
+int main() {
+    string fileName;
+    getFileName(fileName);
+
+    PrimeTable table;
+    if (!table.open(fileName)) {
+        buildTable(fileName);
+        if (!table.open(fileName))
+            return 1;
+    }
+
+    cout << "\nThe table holds all primes upto " << table.limit() << " (inclusive)\n";
+    cout << "\nEnter queries, as one of:\n"
+         << "i x    (is x prime?)\n"
+         << "p x    (number of primes upto x)\n"
+         << "n k    (k-th prime)\n";
+
+    char query;
+    ULL argument;
+    while (cin >> query >> argument) {
+        if (query == 'i')
+            cout << argument << (table.is_prime(argument) ? " is prime\n" : " is not prime\n");
+        else if (query == 'p')
+            cout << "pi(" << argument << ") = " << table.pi(argument) << "\n";
+        else if (query == 'n') {
+            const ULL prime = table.nth_prime(argument);
+            if (prime == 0)
+                cout << "The table does not have a prime number " << argument << "\n";
+            else
+                cout << "Prime number " << argument << " is " << prime << "\n";
+        }
+        else
+            cout << "Unknown query '" << query << "'\n";
+    }
+
+    return 0;
+}
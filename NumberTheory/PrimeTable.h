@@ -0,0 +1,282 @@
+/*
+    Memory-mapped prime table:
+    A versioned binary file format for a precomputed PrimeBitset, which can be
+    memory-mapped and queried straight away, without sieving again. Besides the
+    packed mod-30 wheel bits, the file stores the number of primes before every
+    block of bits, so that pi(x) and nth_prime(n) only need to popcount inside
+    a single block. Opening a table only maps it, so a cold start costs page
+    faults for the parts of the table that get queried, and not O(N) work.
+
+    File layout (all fields in the native byte order of the machine that
+    wrote the table; a table from a machine of the other byte order fails
+    the version check, since the version reads byte-swapped):
+        magic           8 bytes, "PRIMETBL"
+        version         uint32
+        wheel modulus   uint32, always 30
+        prime limit     uint64, the number upto which primes are stored
+        word count      uint64, number of 64-bit words of wheel bits
+        block words     uint64, number of words per prefix count block
+        block count     uint64
+        prefix counts   uint64[block count + 1], wheel primes before each block
+        words           uint64[word count], as in PrimeBitset::data()
+
+    Time complexity:
+    O(1) for is_prime, O(B) for pi(x) and O(log(N / B) + B) for nth_prime(n),
+    where N is the prime limit and B is the number of words per block
+
+    Space complexity:
+    O(N / 30) bytes of (mapped) file, where N is the prime limit
+*/
+
+#ifndef PRIME_TABLE_H
+#define PRIME_TABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PRIME_TABLE_USE_MMAP
+#endif
+
+#include "PrimeBitset.h"
+
+using namespace std;
+
+const char PRIME_TABLE_MAGIC[8] = { 'P', 'R', 'I', 'M', 'E', 'T', 'B', 'L' };
+const uint32_t PRIME_TABLE_VERSION = 1;
+const uint64_t PRIME_TABLE_BLOCK_WORDS = 64;    // 4096 bits, i.e. 15360 numbers per block
+
+struct PrimeTableHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t wheelModulus;
+    uint64_t primeLimit;
+    uint64_t wordCount;
+    uint64_t blockWords;
+    uint64_t blockCount;
+};
+
+// writes the bitset as a prime table file, returns false if the file could not be written
+bool writePrimeTable(const PrimeBitset &primes, const string &fileName) {
+    const vector<uint64_t> &words = primes.data();
+
+    PrimeTableHeader header;
+    memcpy(header.magic, PRIME_TABLE_MAGIC, sizeof(header.magic));
+    header.version = PRIME_TABLE_VERSION;
+    header.wheelModulus = WHEEL_MODULUS;
+    header.primeLimit = primes.limit();
+    header.wordCount = words.size();
+    header.blockWords = PRIME_TABLE_BLOCK_WORDS;
+    header.blockCount = (words.size() + PRIME_TABLE_BLOCK_WORDS - 1) / PRIME_TABLE_BLOCK_WORDS;
+
+    vector<uint64_t> prefixCounts(header.blockCount + 1, 0);
+    for (uint64_t block = 0; block < header.blockCount; block++) {
+        uint64_t blockPrimeCount = 0;
+        for (uint64_t word = block * header.blockWords; word < min<uint64_t>(words.size(), (block + 1) * header.blockWords); word++)
+            blockPrimeCount += popcount64(words[word]);
+        prefixCounts[block + 1] = prefixCounts[block] + blockPrimeCount;
+    }
+
+    ofstream file(fileName, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(prefixCounts.data()), prefixCounts.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(words.data()), words.size() * sizeof(uint64_t));
+
+    return file.good();
+}
+
+class PrimeTable {
+private:
+    const char *fileData;
+    size_t fileSize;
+    vector<char> fileBuffer;    // holds the file when it can not be memory-mapped
+
+    PrimeTableHeader header;
+    const uint64_t *prefixCounts;
+    const uint64_t *words;
+
+    bool is_valid() const;
+
+    // number of set bits in [0, endBit)
+    uint64_t rank(const uint64_t endBit) const {
+        if (endBit == 0)
+            return 0;
+
+        const uint64_t lastWord = (endBit - 1) / 64;
+        const uint64_t block = lastWord / header.blockWords;
+
+        uint64_t setBits = prefixCounts[block];
+        for (uint64_t word = block * header.blockWords; word < lastWord; word++)
+            setBits += popcount64(words[word]);
+        setBits += popcount64(words[lastWord] & (~uint64_t(0) >> (63 - (endBit - 1) % 64)));
+
+        return setBits;
+    }
+
+public:
+    PrimeTable() : fileData(nullptr), fileSize(0), prefixCounts(nullptr), words(nullptr) {}
+    ~PrimeTable() { close(); }
+
+    PrimeTable(const PrimeTable &) = delete;
+    PrimeTable &operator=(const PrimeTable &) = delete;
+
+    // maps the table file, returns false if it could not be read or is not a valid table
+    bool open(const string &fileName);
+    void close();
+
+    bool is_open() const { return words != nullptr; }
+    ULL limit() const { return header.primeLimit; }
+
+    bool is_prime(const ULL num) const {
+        if (num > header.primeLimit)
+            return false;
+        if (num < 7)
+            return num == 2 or num == 3 or num == 5;
+
+        const int bit = WHEEL_BIT[num % WHEEL_MODULUS];
+        if (bit < 0)
+            return false;
+
+        const uint64_t position = num / WHEEL_MODULUS * WHEEL_SPOKES + bit;
+        return (words[position / 64] >> (position % 64)) & 1;
+    }
+
+    // number of primes upto num (inclusive)
+    ULL pi(ULL num) const {
+        if (num > header.primeLimit)
+            num = header.primeLimit;
+
+        ULL primeCount = 0;
+        for (const ULL smallPrime : { 2, 3, 5 })
+            if (smallPrime <= num)
+                primeCount++;
+
+        return primeCount + rank(wheelPosition(num + 1));
+    }
+
+    // the n-th prime (nth_prime(1) is 2), or 0 if it is beyond the limit of the table
+    ULL nth_prime(const ULL n) const;
+};
+
+bool PrimeTable::is_valid() const {
+    if (fileSize < sizeof(PrimeTableHeader))
+        return false;
+    if (memcmp(header.magic, PRIME_TABLE_MAGIC, sizeof(header.magic)) != 0
+            or header.version != PRIME_TABLE_VERSION or header.wheelModulus != WHEEL_MODULUS)
+        return false;
+    if (header.blockWords == 0 or header.wordCount == 0
+            or header.blockCount != (header.wordCount + header.blockWords - 1) / header.blockWords
+            or header.wordCount < wheelPosition(header.primeLimit + 1) / 64 + 1)
+        return false;
+
+    return fileSize == sizeof(PrimeTableHeader) + (header.blockCount + 1 + header.wordCount) * sizeof(uint64_t);
+}
+
+bool PrimeTable::open(const string &fileName) {
+    close();
+
+#ifdef PRIME_TABLE_USE_MMAP
+    const int fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 or fileStatus.st_size == 0) {
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor);    // the mapping stays valid after closing the file
+    if (mapping == MAP_FAILED)
+        return false;
+
+    fileData = static_cast<const char *>(mapping);
+    fileSize = fileStatus.st_size;
+#else
+    ifstream file(fileName, ios::binary | ios::ate);
+    if (!file)
+        return false;
+
+    fileBuffer.resize(file.tellg());
+    file.seekg(0);
+    if (!file.read(fileBuffer.data(), fileBuffer.size()))
+        return false;
+
+    fileData = fileBuffer.data();
+    fileSize = fileBuffer.size();
+#endif
+
+    if (fileSize >= sizeof(PrimeTableHeader))
+        memcpy(&header, fileData, sizeof(header));
+    if (!is_valid()) {
+        close();
+        return false;
+    }
+
+    prefixCounts = reinterpret_cast<const uint64_t *>(fileData + sizeof(PrimeTableHeader));
+    words = prefixCounts + header.blockCount + 1;
+
+    return true;
+}
+
+void PrimeTable::close() {
+#ifdef PRIME_TABLE_USE_MMAP
+    if (fileData != nullptr)
+        munmap(const_cast<char *>(fileData), fileSize);
+#else
+    fileBuffer.clear();
+#endif
+    fileData = nullptr;
+    fileSize = 0;
+    prefixCounts = words = nullptr;
+}
+
+ULL PrimeTable::nth_prime(const ULL n) const {
+    if (n == 0)
+        return 0;
+    if (n <= 3) {   // 2, 3 and 5 are not on the wheel
+        const ULL smallPrime = n == 1 ? 2 : n == 2 ? 3 : 5;
+        return smallPrime <= header.primeLimit ? smallPrime : 0;
+    }
+
+    const uint64_t wheelIndex = n - 3;     // 1-based index among the primes on the wheel
+    if (wheelIndex > prefixCounts[header.blockCount])
+        return 0;
+
+    // last block which has fewer than wheelIndex primes before it
+    uint64_t low = 0, high = header.blockCount - 1;
+    while (low < high) {
+        const uint64_t mid = (low + high + 1) / 2;
+        if (prefixCounts[mid] < wheelIndex)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    uint64_t remaining = wheelIndex - prefixCounts[low];
+    for (uint64_t word = low * header.blockWords; ; word++) {
+        const uint64_t wordPrimeCount = popcount64(words[word]);
+        if (remaining > wordPrimeCount) {
+            remaining -= wordPrimeCount;
+            continue;
+        }
+
+        // clear the lower set bits, until the one we want is the lowest
+        uint64_t bits = words[word];
+        for (; remaining > 1; remaining--)
+            bits &= bits - 1;
+
+        return wheelNumber(word * 64 + countTrailingZeros64(bits));
+    }
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+    Prime numbers using segmented Sieve of Eratosthenes:
+    Given a range [L, R], find all prime numbers in it using the segmented
+    Sieve of Eratosthenes method, which sieves the range one cache-sized
+    segment at a time and so scales well beyond 10^7 (see SegmentedSieve.h).
+    The segments can be shared among several threads
+    (see ParallelSegmentedSieve.h).
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O(N * log(log(N))), where N is the upper limit of the range
+
+    Space complexity:
+    O(sqrt(N) + S), where N is the upper limit of the range and S is the
+    segment size
+*/
+
+#include <iostream>
+#include <string>
+
+#include "ParallelSegmentedSieve.h"
+#include "SegmentedSieve.h"
+#include "../Utils/BufferedWriter.h"
+
+using namespace std;
+
+void getRange(ULL &low, ULL &high) {
+    cout << "Enter the range [L, R] in which primes are to be found : ";
+    cin >> low >> high;
+    cin.ignore();
+
+    if (low > high) {
+        cout << "L should not be greater than R! Try again.\n";
+        getRange(low, high);
+    }
+}
+
+void getWhetherToCountOnly(bool &toCountOnly) {
+    string answer;
+    cout << "\nOnly count the primes instead of printing them?\n";
+    cout << "[y]es / [N]o : ";
+    getline(cin, answer);
+
+    toCountOnly = (answer[0] == 'y' or answer[0] == 'Y');
+}
+
+void getThreadCount(unsigned int &threadCount) {
+    string answer;
+    cout << "\nNumber of threads to use? (default " << defaultThreadCount() << ") : ";
+    getline(cin, answer);
+
+    threadCount = answer.empty() ? defaultThreadCount() : stoul(answer);
+    if (threadCount == 0) {
+        cout << "There should be at least 1 thread! Try again.\n";
+        getThreadCount(threadCount);
+    }
+}
+
+int main() {
+    ios_base::sync_with_stdio(false);   // don't sync C++ streams with C streams
+
+    ULL low, high;
+    getRange(low, high);
+
+    bool toCountOnly;
+    getWhetherToCountOnly(toCountOnly);
+
+    unsigned int threadCount;
+    getThreadCount(threadCount);
+
+    if (toCountOnly) {
+        cout << "\nThere are " << (threadCount == 1 ? countPrimes(low, high) : parallelCountPrimes(low, high, threadCount)) << " prime numbers between "
+             << low << " and " << high << " (inclusive)\n";
+    } else {
+        cout << "\nAll prime numbers between " << low << " and " << high << " (inclusive) are:\n";
+        BufferedWriter output;
+        auto printPrime = [&output](const ULL prime) {
+            output << prime << '\n';
+        };
+
+        if (threadCount == 1)
+            forEachPrime(low, high, printPrime);
+        else
+            parallelForEachPrime(low, high, printPrime, threadCount);
+    }
+
+    return 0;
+}
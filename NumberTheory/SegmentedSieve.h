@@ -0,0 +1,142 @@
+/*
+    Segmented Sieve of Eratosthenes:
+    Find all prime numbers in a range [L, R] by sieving it one small segment at
+    a time. The base primes upto sqrt(R) are found with the simple sieve, and
+    each segment is small enough to stay in the L1/L2 cache while all of them
+    cross off their multiples in it. Every finished segment is handed over to
+    the caller, so primes can be streamed out without ever holding the whole
+    range in memory.
+
+    Time complexity:
+    O(N * log(log(N)) + (N / S) * sqrt(N) / log(N)), where N is the upper limit
+    R and S is the segment size
+
+    Space complexity:
+    O(sqrt(N) + S), where N is the upper limit R and S is the segment size
+*/
+
+#ifndef SEGMENTED_SIEVE_H
+#define SEGMENTED_SIEVE_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "SimpleSieve.h"
+
+using namespace std;
+
+typedef unsigned long long int ULL;
+
+const size_t DEFAULT_SEGMENT_SIZE = 1 << 15;    // 32 KiB, fits in the L1 cache
+
+// largest number whose square is not greater than n
+ULL integerSqrt(const ULL n) {
+    ULL root = sqrt((long double) n);
+
+    // correct the rounding errors of the floating point square root
+    while (root > 0 and root * root > n)
+        root--;
+    while ((root + 1) * (root + 1) <= n)
+        root++;
+
+    return root;
+}
+
+// all primes upto sqrt(primeLimit), which are enough to sieve upto primeLimit
+vector<unsigned int> basePrimes(const ULL primeLimit) {
+    const unsigned int root = integerSqrt(primeLimit);
+    vector<unsigned int> primes;
+
+    if (root < 2)
+        return primes;
+
+    const vector<bool> isPrime = simpleSieve(root);
+    for (unsigned int num = 2; num <= root; num++)
+        if (isPrime[num])
+            primes.push_back(num);
+
+    return primes;
+}
+
+/*
+    Sieves the range [low, high] using the given base primes (which must
+    include all primes upto sqrt(high)), and calls
+        handleSegment(segmentStart, isPrime, segmentLength)
+    for each segment, in increasing order, where isPrime[i] is non-zero
+    if (segmentStart + i) is prime.
+*/
+template <typename SegmentHandler>
+void segmentedSieve(const ULL low, const ULL high, const vector<unsigned int> &primes,
+                    SegmentHandler handleSegment, const size_t segmentSize = DEFAULT_SEGMENT_SIZE) {
+    if (low > high)
+        return;
+
+    vector<char> isPrime(segmentSize);
+
+    // next multiple of each base prime that is yet to be crossed off
+    vector<ULL> nextMultiple(primes.size());
+    for (size_t i = 0; i < primes.size(); i++) {
+        const ULL prime = primes[i];
+        // smaller multiples have already been crossed off by smaller primes
+        nextMultiple[i] = max(prime * prime, (low + prime - 1) / prime * prime);
+    }
+
+    for (ULL segmentStart = low; ; segmentStart += segmentSize) {
+        const ULL segmentEnd = min(high, segmentStart + (segmentSize - 1));
+        const size_t segmentLength = segmentEnd - segmentStart + 1;
+
+        fill(isPrime.begin(), isPrime.begin() + segmentLength, 1);
+
+        // 0 and 1 are not prime
+        for (ULL num = segmentStart; num < 2 and num <= segmentEnd; num++)
+            isPrime[num - segmentStart] = 0;
+
+        for (size_t i = 0; i < primes.size(); i++) {
+            const ULL prime = primes[i];
+            if (prime * prime > segmentEnd)     // neither this nor any larger prime has a multiple to cross off yet
+                break;
+
+            ULL multiple = nextMultiple[i];
+            for (; multiple <= segmentEnd; multiple += prime)
+                isPrime[multiple - segmentStart] = 0;   // mark its multiples as not prime
+            nextMultiple[i] = multiple;     // carry over to the next segment
+        }
+
+        handleSegment(segmentStart, isPrime, segmentLength);
+
+        if (segmentEnd == high)
+            break;
+    }
+}
+
+template <typename SegmentHandler>
+void segmentedSieve(const ULL low, const ULL high, SegmentHandler handleSegment,
+                    const size_t segmentSize = DEFAULT_SEGMENT_SIZE) {
+    segmentedSieve(low, high, basePrimes(high), handleSegment, segmentSize);
+}
+
+// calls handlePrime(prime) for every prime in [low, high], in increasing order
+template <typename PrimeHandler>
+void forEachPrime(const ULL low, const ULL high, PrimeHandler handlePrime,
+                  const size_t segmentSize = DEFAULT_SEGMENT_SIZE) {
+    segmentedSieve(low, high,
+        [&handlePrime](const ULL segmentStart, const vector<char> &isPrime, const size_t segmentLength) {
+            for (size_t i = 0; i < segmentLength; i++)
+                if (isPrime[i])
+                    handlePrime(segmentStart + i);
+        }, segmentSize);
+}
+
+// number of primes in [low, high]
+ULL countPrimes(const ULL low, const ULL high, const size_t segmentSize = DEFAULT_SEGMENT_SIZE) {
+    ULL primeCount = 0;
+    segmentedSieve(low, high,
+        [&primeCount](const ULL, const vector<char> &isPrime, const size_t segmentLength) {
+            primeCount += count(isPrime.begin(), isPrime.begin() + segmentLength, 1);
+        }, segmentSize);
+
+    return primeCount;
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+    Sieve benchmark:
+    Times prime counting upto N with the simple sieve (when N fits in an
+    unsigned int) and with the parallel segmented sieve using 1, 2, 4 and 8
+    threads, and checks that all of them agree.
+
+    Usage: ./SieveBenchmark.out [N]    (N is 10^9 by default)
+
+    (Compile with the -O2 and -pthread flags when using the CLI.)
+*/
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "ParallelSegmentedSieve.h"
+#include "SimpleSieve.h"
+
+using namespace std;
+
+template <typename Function>
+double secondsToRun(Function function) {
+    const auto start = chrono::steady_clock::now();
+    function();
+    const auto end = chrono::steady_clock::now();
+
+    return chrono::duration<double>(end - start).count();
+}
+
+void printResult(const string &name, const ULL primeCount, const double seconds, const double baselineSeconds) {
+    cout << left << setw(24) << name << right
+         << setw(14) << primeCount
+         << setw(12) << fixed << setprecision(3) << seconds
+         << setw(10) << setprecision(2) << baselineSeconds / seconds << "x\n";
+}
+
+int main(int argc, char *argv[]) {
+    const ULL primeLimit = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1000000000ULL;
+
+    cout << "Counting primes upto " << primeLimit << "\n\n";
+    cout << left << setw(24) << "sieve" << right << setw(14) << "primes"
+         << setw(12) << "seconds" << setw(11) << "speedup" << "\n";
+
+    ULL expectedCount = 0;
+    double baselineSeconds = 0;
+    bool isCorrect = true;
+
+    if (primeLimit < UINT_MAX) {
+        const double seconds = secondsToRun([&]() {
+            const vector<bool> isPrime = simpleSieve(primeLimit);
+            for (unsigned int num = 2; num <= primeLimit; num++)
+                expectedCount += isPrime[num];
+        });
+        baselineSeconds = seconds;
+        printResult("simpleSieve", expectedCount, seconds, baselineSeconds);
+    }
+
+    for (unsigned int threadCount = 1; threadCount <= 8; threadCount *= 2) {
+        ULL primeCount = 0;
+        const double seconds = secondsToRun([&]() {
+            primeCount = parallelCountPrimes(0, primeLimit, threadCount);
+        });
+
+        if (baselineSeconds == 0) {     // no simple sieve, compare against 1 thread
+            expectedCount = primeCount;
+            baselineSeconds = seconds;
+        }
+        isCorrect = isCorrect and primeCount == expectedCount;
+
+        printResult("segmented, " + to_string(threadCount) + " thread(s)", primeCount, seconds, baselineSeconds);
+    }
+
+    if (!isCorrect) {
+        cout << "\nThe prime counts do not match!\n";
+        return 1;
+    }
+
+    return 0;
+}
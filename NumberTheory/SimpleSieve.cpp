@@ -11,30 +11,19 @@
     O(N), where N is the number upto which primes have to be found
 */
 
-#include <cmath>
 #include <iostream>
 #include <vector>
 
-using namespace std;
-
-vector<bool> simpleSieve(const unsigned int &primeLimit) {
-    vector<bool> isPrime(primeLimit + 1, true);   // "sieve" to mark numbers as prime
-
-    isPrime[0] = isPrime[1] = false;
+#include "SimpleSieve.h"
+#include "../Utils/BufferedWriter.h"
 
-    unsigned int multiple;
-    for (unsigned int num = 2; num <= sqrt(primeLimit); num++)
-        if (isPrime[num])   // if the number is prime
-            for (multiple = num * num; multiple <= primeLimit; multiple += num)
-                isPrime[multiple] = false;  // mark its multiples as not prime
-
-    return isPrime;
-}
+using namespace std;
 
 void printPrimes(const vector<bool> &markedPrimes) {
+    BufferedWriter output;
     for (unsigned int num = 2; num < markedPrimes.size(); num++)
         if (markedPrimes[num])  // if number is marked as prime
-            cout << num << "\n";
+            output << num << '\n';
 }
 
 void getPrimeLimit(unsigned int &primeLimit)
@@ -0,0 +1,37 @@
+/*
+    Simple Sieve of Eratosthenes:
+    Marks every number upto N (inclusive) as either prime or not prime.
+    Shared by the programs in NumberTheory/ that need a table of small primes.
+
+    Time complexity:
+    O(N * log(log(N))), where N is the number upto which primes have to be found
+
+    Space complexity:
+    O(N), where N is the number upto which primes have to be found
+*/
+
+#ifndef SIMPLE_SIEVE_H
+#define SIMPLE_SIEVE_H
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+vector<bool> simpleSieve(const unsigned int &primeLimit) {
+    vector<bool> isPrime(primeLimit + 1, true);   // "sieve" to mark numbers as prime
+
+    isPrime[0] = false;
+    if (primeLimit >= 1)
+        isPrime[1] = false;
+
+    unsigned int multiple;
+    for (unsigned int num = 2; num <= sqrt(primeLimit); num++)
+        if (isPrime[num])   // if the number is prime
+            for (multiple = num * num; multiple <= primeLimit; multiple += num)
+                isPrime[multiple] = false;  // mark its multiples as not prime
+
+    return isPrime;
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+    Batched search:
+    Binary search for many queries at once, with the searches run in
+    lockstep so that their cache misses overlap (see BatchedSearch.h)
+*/
+
+#include <algorithm>    // for is_sorted()
+#include <iostream>
+#include <vector>
+
+#include "BatchedSearch.h"
+#include "SearchingUtils.h"
+
+using namespace std;
+
+int main() {
+    vector<int> sortedValues;
+    if (!getSortedValues(sortedValues))
+        return 1;
+
+    prompt("Enter the values to search for (end the input to stop) :\n");
+    vector<int> queries;
+    standardInput().read_all(queries);
+
+    // the sweep is the faster one when the queries come in order
+    vector<size_t> answers;
+    if (is_sorted(queries.begin(), queries.end()))
+        sortedQueriesLowerBound(sortedValues, queries, answers);
+    else
+        batchLowerBound(sortedValues, queries, answers);
+
+    cout << "\n";
+    for (size_t i = 0; i < queries.size(); i++) {
+        if (answers[i] < sortedValues.size() and sortedValues[answers[i]] == queries[i])
+            cout << "Found " << queries[i] << " at position " << (answers[i] + 1) << "\n";
+        else
+            cout << queries[i] << " is not present\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+    Batched search:
+    Binary search for many queries at once, against the same sorted array.
+    A single binary search waits for one cache miss per level of a large
+    array, with nothing else to do meanwhile. batchLowerBound instead runs
+    the searches of BATCH_SEARCH_WIDTH queries in lockstep: since they all
+    search the same array, they all take the same number of steps, and at
+    each step it probes the array once for every query, so that their cache
+    misses overlap. Each search is branchless (it moves its base by half of
+    the range or not, depending on the comparison), and prefetches its next
+    probe as soon as it knows where that is, which is BATCH_SEARCH_WIDTH
+    probes before it is needed.
+
+    With AVX2, the probes of 8 queries are loaded with one gather, compared
+    with one compare, and their bases moved with one add (two vectors at a
+    time, so 16 searches are in flight). This is faster while the array
+    stays in cache, up to BATCH_SEARCH_SIMD_MAX_SIZE values; beyond that the
+    gathers stall on their cache misses, and the prefetching scalar version
+    is faster, so that is the one used. Whether AVX2 is there is checked at
+    runtime.
+
+    sortedQueriesLowerBound is for queries sorted in ascending order: it
+    sweeps the array once from left to right, like a merge, finding each
+    answer by galloping (exponential search) forward from the previous one,
+    so that queries close together cost O(1) each. It still gives the right
+    answers for unsorted queries, only slower.
+
+    Usage:
+        vector<size_t> answers;
+        batchLowerBound(sortedValues, queries, answers);   // like lower_bound() for each query
+
+    Time complexity:
+    O(m * log(n)) for batchLowerBound, and O(m * log(n / m) + m) for
+    sortedQueriesLowerBound, where n is the number of values, and m is the
+    number of queries
+
+    Space complexity:
+    O(1), besides the answers
+*/
+
+#ifndef BATCHED_SEARCH_H
+#define BATCHED_SEARCH_H
+
+#include <algorithm>    // for lower_bound(), min()
+#include <cstdint>
+#include <vector>
+
+#include "SearchingUtils.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BATCHED_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+const size_t BATCH_SEARCH_WIDTH = 16;     // searches in flight at once
+const size_t BATCH_SEARCH_SIMD_MAX_SIZE = 1 << 18;   // 1 MiB of values, about what stays in L2
+
+/*
+    Answers queries[0, count) (count <= BATCH_SEARCH_WIDTH) with the positions
+    of their lower bounds in values[0, size), in lockstep (size > 0)
+*/
+void batchLowerBoundScalar(const int* values, const size_t size, const int* queries, const size_t count,
+                           size_t* answers) {
+    const uintptr_t first = reinterpret_cast<uintptr_t>(values);
+    size_t bases[BATCH_SEARCH_WIDTH] = {};
+
+    // each base stays the start of a range of length values holding the lower bound, or just before it
+    for (size_t length = size; length > 1; ) {
+        const size_t half = length / 2;
+        length -= half;
+        const size_t nextProbe = length / 2 > 0 ? length / 2 - 1 : 0;
+
+        for (size_t i = 0; i < count; i++) {
+            bases[i] += (values[bases[i] + half - 1] < queries[i]) * half;
+            prefetch(first + (bases[i] + nextProbe) * sizeof(int));
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+        answers[i] = bases[i] + (values[bases[i]] < queries[i]);
+}
+
+#ifdef BATCHED_SEARCH_X86
+
+// as batchLowerBoundScalar, for exactly 16 queries, 8 to a vector (size <= INT_MAX, for 32-bit positions)
+__attribute__((target("avx2")))
+void batchLowerBoundAVX2(const int* values, const size_t size, const int* queries, size_t* answers) {
+    const __m256i queries1 = _mm256_loadu_si256((const __m256i*) queries);
+    const __m256i queries2 = _mm256_loadu_si256((const __m256i*) (queries + 8));
+    __m256i bases1 = _mm256_setzero_si256();
+    __m256i bases2 = _mm256_setzero_si256();
+
+    for (size_t length = size; length > 1; ) {
+        const size_t half = length / 2;
+        length -= half;
+
+        const __m256i halves = _mm256_set1_epi32(int(half));
+        const __m256i probes1 = _mm256_add_epi32(bases1, _mm256_set1_epi32(int(half) - 1));
+        const __m256i probes2 = _mm256_add_epi32(bases2, _mm256_set1_epi32(int(half) - 1));
+        const __m256i probed1 = _mm256_i32gather_epi32(values, probes1, sizeof(int));
+        const __m256i probed2 = _mm256_i32gather_epi32(values, probes2, sizeof(int));
+
+        // where the probed value is less than the query, the base moves by half
+        bases1 = _mm256_add_epi32(bases1, _mm256_and_si256(_mm256_cmpgt_epi32(queries1, probed1), halves));
+        bases2 = _mm256_add_epi32(bases2, _mm256_and_si256(_mm256_cmpgt_epi32(queries2, probed2), halves));
+    }
+
+    // the comparisons are all ones (-1) where the base is just before the lower bound
+    const __m256i last1 = _mm256_i32gather_epi32(values, bases1, sizeof(int));
+    const __m256i last2 = _mm256_i32gather_epi32(values, bases2, sizeof(int));
+    bases1 = _mm256_sub_epi32(bases1, _mm256_cmpgt_epi32(queries1, last1));
+    bases2 = _mm256_sub_epi32(bases2, _mm256_cmpgt_epi32(queries2, last2));
+
+    int positions[BATCH_SEARCH_WIDTH];
+    _mm256_storeu_si256((__m256i*) positions, bases1);
+    _mm256_storeu_si256((__m256i*) (positions + 8), bases2);
+    for (size_t i = 0; i < BATCH_SEARCH_WIDTH; i++)
+        answers[i] = positions[i];
+}
+
+#endif
+
+// answers each query with the position of its lower bound in sortedValues (the first value not less than it)
+void batchLowerBound(const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers,
+                     const bool canUseSIMD = true) {
+    answers.assign(queries.size(), 0);
+    if (sortedValues.empty())
+        return;
+
+    size_t first = 0;
+
+#ifdef BATCHED_SEARCH_X86
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+    if (canUseSIMD and hasAVX2 and sortedValues.size() <= BATCH_SEARCH_SIMD_MAX_SIZE) {
+        for (; first + BATCH_SEARCH_WIDTH <= queries.size(); first += BATCH_SEARCH_WIDTH)
+            batchLowerBoundAVX2(sortedValues.data(), sortedValues.size(), queries.data() + first,
+                                answers.data() + first);
+    }
+#else
+    (void) canUseSIMD;
+#endif
+
+    for (; first < queries.size(); first += BATCH_SEARCH_WIDTH)
+        batchLowerBoundScalar(sortedValues.data(), sortedValues.size(), queries.data() + first,
+                              min(BATCH_SEARCH_WIDTH, queries.size() - first), answers.data() + first);
+}
+
+// answers each query with the position of its lower bound in sortedValues, sweeping them in order
+void sortedQueriesLowerBound(const vector<int>& sortedValues, const vector<int>& sortedQueries,
+                             vector<size_t>& answers) {
+    answers.assign(sortedQueries.size(), 0);
+    const size_t size = sortedValues.size();
+    size_t position = 0;    // the previous answer, where the search for the next one starts
+
+    for (size_t i = 0; i < sortedQueries.size(); i++) {
+        const int query = sortedQueries[i];
+        if (i > 0 and query < sortedQueries[i - 1])     // out of order: start over
+            position = 0;
+
+        if (position < size and sortedValues[position] < query) {
+            // gallop: double the step until it passes the lower bound, which is then in (low, high]
+            size_t low = position, step = 1;
+            while (low + step < size and sortedValues[low + step] < query) {
+                low += step;
+                step *= 2;
+            }
+            const size_t high = min(low + step, size);
+            position = lower_bound(sortedValues.begin() + low + 1, sortedValues.begin() + high, query)
+                       - sortedValues.begin();
+        }
+
+        answers[i] = position;
+    }
+}
+
+#endif
@@ -4,43 +4,30 @@
     within a sorted array
 */
 
+#include <algorithm>    // for max()
 #include <iostream>
 #include <vector>
 
-using namespace std;
+#include "BinarySearch.h"
+#include "../Utils/FastInput.h"
 
-int binarySearch(const int value, const vector<int>& sortedVect, const int low, const int high) {
-    int mid = (low + high) / 2;
-
-    if (value == sortedVect[mid])
-        return mid;
-    else if (low <= high) {
-        if (value < sortedVect[mid]) {
-            // value must be between indices low and mid-1, if exists
-            return binarySearch(value, sortedVect, low, mid-1);
-        }
-        else if (value > sortedVect[mid]) {
-            // value must be between indices mid-1 and high, if exists
-            return binarySearch(value, sortedVect, mid+1, high);
-        }
-    }
-
-    return -1;
-}
+using namespace std;
 
 int main() {
-    int value;
-    cout << "Enter the value to search for : ";
-    cin >> value;
+    BufferedReader& input = standardInput();
+
+    int value = 0;
+    prompt("Enter the value to search for : ");
+    input.read(value);
 
-    int size;
-    cout << "Enter the input size : ";
-    cin >> size;
+    int size = 0;
+    prompt("Enter the input size : ");
+    input.read(size);
+    size = max(size, 0);
 
     vector<int> inputVect(size);    // supposedly sorted values
-    cout << "Enter " << size << " integers in ascending order :\n";
-    for (int& val: inputVect)
-        cin >> val;
+    prompt("Enter " + to_string(size) + " integers in ascending order :\n");
+    input.read_all(inputVect.data(), inputVect.size());
 
     int index = binarySearch(value, inputVect, 0, size-1);
     cout << "\n";
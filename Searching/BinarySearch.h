@@ -0,0 +1,39 @@
+/*
+    Binary search:
+    A search algorithm that finds the position of a target value
+    within a sorted array
+
+    Time complexity:
+    O(log(n)), where n is the number of values
+
+    Space complexity:
+    O(log(n)), for the recursion
+*/
+
+#ifndef BINARY_SEARCH_H
+#define BINARY_SEARCH_H
+
+#include <vector>
+
+using namespace std;
+
+// the position of value in sortedVect[low, high], or -1 if it is not there
+int binarySearch(const int value, const vector<int>& sortedVect, const int low, const int high) {
+    if (low > high)
+        return -1;
+
+    int mid = low + (high - low) / 2;
+
+    if (value == sortedVect[mid])
+        return mid;
+    else if (value < sortedVect[mid]) {
+        // value must be between indices low and mid-1, if exists
+        return binarySearch(value, sortedVect, low, mid-1);
+    }
+    else {
+        // value must be between indices mid+1 and high, if exists
+        return binarySearch(value, sortedVect, mid+1, high);
+    }
+}
+
+#endif
@@ -0,0 +1,23 @@
+/*
+    Eytzinger search:
+    Binary search over a sorted array laid out in breadth-first order, with a
+    branchless, prefetching descent (see EytzingerSearch.h)
+*/
+
+#include <vector>
+
+#include "EytzingerSearch.h"
+#include "SearchingUtils.h"
+
+using namespace std;
+
+int main() {
+    vector<int> sortedValues;
+    if (!getSortedValues(sortedValues))
+        return 1;
+
+    const EytzingerIndex index(sortedValues);
+    answerQueries(index);
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+    Eytzinger search:
+    Binary search over a sorted array rearranged in Eytzinger (breadth-first)
+    order: the root of the implicit search tree is at index 1, and the
+    children of index k are at 2k and 2k + 1. Where binarySearch jumps all
+    over the array, so that every probe of a large one is a cache miss, the
+    first levels of this tree share a few cache lines that stay cached, and
+    the descent from k only ever goes to 2k or 2k + 1.
+
+    The descent is branchless (the next index is computed from the
+    comparison, not chosen by it, so there is nothing to mispredict), and
+    prefetches the 16 descendants of k four levels down, which share the
+    cache line that starts at 16k, while it does the next four comparisons.
+    The path ends past the leaves, and the answer is the last node the
+    descent went left at, found by stripping the right turns (trailing ones)
+    from the final index.
+
+    Usage:
+        EytzingerIndex index(sortedValues);
+        index.lower_bound(value);   // the position of the first value not less than value
+        index.contains(value);
+
+    (At most 2^32 - 1 values, for the 32-bit positions.)
+
+    Time complexity:
+    O(n) to build the index, and O(log(n)) per search, where n is the number
+    of values
+
+    Space complexity:
+    O(n), for the values and their positions in sorted order
+*/
+
+#ifndef EYTZINGER_SEARCH_H
+#define EYTZINGER_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "SearchingUtils.h"
+
+using namespace std;
+
+const size_t EYTZINGER_PREFETCH_STRIDE = CACHE_LINE_BYTES / sizeof(int);  // nodes per cache line (4 levels)
+
+class EytzingerIndex {
+private:
+    CacheAlignedArray<int> keys;        // in Eytzinger order, from index 1
+    vector<uint32_t> positions;         // of each key in the sorted array
+    size_t count;
+
+    // fills the subtree rooted at k with sortedValues[next, ...) in order; returns where it stopped
+    size_t build(const vector<int>& sortedValues, size_t next, const size_t k) {
+        if (k <= count) {
+            next = build(sortedValues, next, 2 * k);
+            keys[k] = sortedValues[next];
+            positions[k] = next++;
+            next = build(sortedValues, next, 2 * k + 1);
+        }
+        return next;
+    }
+
+    // the node of the first key greater than value (or not less than it, unless isStrict); 0 if none is
+    size_t descend(const int value, const bool isStrict) const {
+        const uintptr_t first = reinterpret_cast<uintptr_t>(keys.data());
+        size_t k = 1;
+
+        while (k <= count) {
+            prefetch(first + EYTZINGER_PREFETCH_STRIDE * k * sizeof(int));
+            k = 2 * k + (isStrict ? keys[k] <= value : keys[k] < value);
+        }
+
+        // undo the right turns since the last left turn, and that left turn too
+        k >>= __builtin_ffsll(~(unsigned long long) k);
+        return k;
+    }
+
+public:
+    explicit EytzingerIndex(const vector<int>& sortedValues)
+        : keys(sortedValues.size() + 1), positions(sortedValues.size() + 1), count(sortedValues.size()) {
+        build(sortedValues, 0, 1);
+    }
+
+    size_t size() const { return count; }
+
+    // the position of the first value not less than value in the sorted array, or size() if there is none
+    size_t lower_bound(const int value) const {
+        const size_t k = descend(value, false);
+        return k == 0 ? count : positions[k];
+    }
+
+    // the position of the first value greater than value in the sorted array, or size() if there is none
+    size_t upper_bound(const int value) const {
+        const size_t k = descend(value, true);
+        return k == 0 ? count : positions[k];
+    }
+
+    bool contains(const int value) const {
+        const size_t k = descend(value, false);
+        return k != 0 and keys[k] == value;
+    }
+};
+
+#endif
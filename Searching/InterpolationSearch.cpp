@@ -0,0 +1,48 @@
+/*
+    Interpolation search and learned index:
+    Searches that guess where a value is from the values themselves, for
+    sorted values spread about evenly over their range, with a report of
+    how many probes they make, against binary search (see
+    InterpolationSearch.h)
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "InterpolationSearch.h"
+#include "SearchingUtils.h"
+
+using namespace std;
+
+int main() {
+    vector<int> sortedValues;
+    if (!getSortedValues(sortedValues))
+        return 1;
+
+    prompt("Enter the values to search for (end the input to stop) :\n");
+    vector<int> queries;
+    standardInput().read_all(queries);
+
+    const LearnedIndex index(sortedValues);
+
+    cout << "\n";
+    for (const int value : queries) {
+        const int position = index.find(value);
+        if (position != -1)
+            cout << "Found " << value << " at position " << (position + 1) << "\n";
+        else
+            cout << value << " is not present\n";
+    }
+
+    const SearchCostReport costs = reportSearchCosts(sortedValues, queries);
+    cout << "\nProbes per search (average, and at most):\n";
+    cout << "Binary search        : " << costs.binarySearchProbes << "\n";
+    cout << "Interpolation search : " << costs.interpolationProbes << ", " << costs.maxInterpolationProbes << "\n";
+    cout << "Learned index        : " << costs.learnedIndexProbes << ", " << costs.maxLearnedIndexProbes;
+    if (costs.isLearnedIndexUsingModel)
+        cout << " (" << costs.learnedIndexSegments << " segments)\n";
+    else
+        cout << " (fell back to binary search: the model would not save probes over it)\n";
+
+    return 0;
+}
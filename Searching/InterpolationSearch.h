@@ -0,0 +1,304 @@
+/*
+    Interpolation search and learned index:
+    Searches that use the values themselves to guess where a value is,
+    instead of always halving the range, for sorted values that are spread
+    about evenly over their range (uniformly distributed).
+
+    interpolationSearch guesses the position of the value by linear
+    interpolation between the values at the ends of the range it is in, and
+    narrows the range to one side of the guess. On uniform values that takes
+    O(log(log(n))) probes, but on skewed values it can take O(n), so it
+    counts the steps that fail to halve the range, and after
+    INTERPOLATION_SLOW_STEPS of them, finishes with binary search. Every
+    other step halves the range at least, so it makes at most
+    log2(n) + INTERPOLATION_SLOW_STEPS + 3 probes.
+
+    LearnedIndex is a small piecewise linear model of the positions of the
+    values (a two-layer recursive model index): a linear root model maps a
+    value to one of about n / LEARNED_INDEX_KEYS_PER_SEGMENT segments, and a
+    least-squares line fitted to the values of that segment predicts the
+    position. The largest errors of each segment's line, measured when the
+    index is built, bound where the value can be, and a binary search over
+    just that window (the last mile) finds it. If the model would not save
+    probes over binary search (when most of the values share a segment, and
+    their positions are far from linear, as with a dense cluster of values
+    and a few far outliers), the index falls back to plain binary search.
+
+    Both count their probes (reads of the sorted values), and
+    reportSearchCosts compares them with binary search for a set of queries.
+
+    Usage:
+        LearnedIndex index(sortedValues);
+        index.lower_bound(value);    // the position of the first value not less than value
+        index.find(value);           // as binarySearch: the position of value, or -1
+
+    Time complexity:
+    O(log(log(n))) probes on uniform values, and O(log(n)) at worst, for
+    interpolationSearch; O(n) to build the learned index, and O(log(e)) per
+    search, where e is the largest error of the model (O(log(n)) with the
+    fallback)
+
+    Space complexity:
+    O(1) for interpolationSearch; O(n / LEARNED_INDEX_KEYS_PER_SEGMENT) for
+    the learned index
+*/
+
+#ifndef INTERPOLATION_SEARCH_H
+#define INTERPOLATION_SEARCH_H
+
+#include <algorithm>    // for max(), min()
+#include <cmath>
+#include <vector>
+
+#include "BinarySearch.h"
+
+using namespace std;
+
+const size_t INTERPOLATION_SLOW_STEPS = 6;     // steps that fail to halve the range before binary search takes over
+const size_t LEARNED_INDEX_KEYS_PER_SEGMENT = 256;
+
+// the number of probes binary search makes over size values
+size_t binarySearchProbes(const size_t size) {
+    size_t probes = 0;
+    for (size_t length = size; length > 0; length /= 2)
+        probes++;
+    return probes;
+}
+
+// the position of the first of sortedVect[first, last) not less than value (or last), counting the probes
+size_t countedLowerBound(const vector<int>& sortedVect, size_t first, size_t last, const int value, size_t& probes) {
+    while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        probes++;
+        if (sortedVect[mid] < value)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+    return first;
+}
+
+// the position of the first value not less than value in sortedVect (or its size), counting the probes
+size_t interpolationSearch(const int value, const vector<int>& sortedVect, size_t& probes) {
+    const size_t size = sortedVect.size();
+    probes = 0;
+    if (size == 0)
+        return 0;
+
+    probes++;
+    if (value <= sortedVect[0])
+        return 0;
+    probes++;
+    if (value > sortedVect[size - 1])
+        return size;
+
+    // sortedVect[left] < value <= sortedVect[right]; the answer is in (left, right]
+    size_t left = 0, right = size - 1;
+    long long leftValue = sortedVect[left], rightValue = sortedVect[right];
+    size_t slowSteps = 0;
+
+    while (right - left > 1) {
+        if (slowSteps == INTERPOLATION_SLOW_STEPS)  // skewed values: finish with binary search
+            return countedLowerBound(sortedVect, left + 1, right, value, probes);
+        const size_t length = right - left;
+
+        // the guess, interpolated between the ends, but strictly inside them, so that the range shrinks
+        const double fraction = double(value - leftValue) / double(rightValue - leftValue);
+        size_t guess = left + size_t(fraction * (right - left));
+        guess = min(max(guess, left + 1), right - 1);
+
+        probes++;
+        if (sortedVect[guess] < value) {
+            left = guess;
+            leftValue = sortedVect[guess];
+        } else {
+            right = guess;
+            rightValue = sortedVect[guess];
+        }
+
+        if (2 * (right - left) > length)
+            slowSteps++;
+    }
+
+    return right;
+}
+
+size_t interpolationSearch(const int value, const vector<int>& sortedVect) {
+    size_t probes;
+    return interpolationSearch(value, sortedVect, probes);
+}
+
+class LearnedIndex {
+private:
+    // a line predicting the positions of the values mapped to this segment, which are [first, last)
+    struct Segment {
+        double slope;
+        double intercept;
+        size_t first;
+        size_t last;
+        double minError;    // of position - prediction, over the segment's values
+        double maxError;
+    };
+
+    const vector<int>& sortedVect;
+    vector<Segment> segments;
+    double minValue;
+    double rootSlope;       // segments per unit of value
+    bool isUsingModel;
+    double expectedProbes;  // averaged over the values' segments
+
+    // the segment of value (monotone in value, so each segment holds a contiguous range of the values)
+    size_t segment_of(const int value) const {
+        const double segment = (double(value) - minValue) * rootSlope;
+        if (segment <= 0)
+            return 0;
+        return min(size_t(segment), segments.size() - 1);
+    }
+
+    static double predict(const Segment& segment, const int value) {
+        return segment.slope * double(value) + segment.intercept;
+    }
+
+    // fits the segment's line to the positions of its values by least squares, and measures its errors
+    void fit(Segment& segment) const {
+        const size_t count = segment.last - segment.first;
+        segment.slope = 0;
+        segment.intercept = segment.first;
+        segment.minError = segment.maxError = 0;
+        if (count == 0)
+            return;
+
+        double meanValue = 0, meanPosition = 0;
+        for (size_t i = segment.first; i < segment.last; i++) {
+            meanValue += sortedVect[i];
+            meanPosition += i;
+        }
+        meanValue /= count;
+        meanPosition /= count;
+
+        double covariance = 0, variance = 0;
+        for (size_t i = segment.first; i < segment.last; i++) {
+            covariance += (sortedVect[i] - meanValue) * (i - meanPosition);
+            variance += (sortedVect[i] - meanValue) * (sortedVect[i] - meanValue);
+        }
+
+        // (the slope is never negative, so that the predictions stay in order)
+        segment.slope = variance > 0 ? max(covariance / variance, 0.0) : 0;
+        segment.intercept = meanPosition - segment.slope * meanValue;
+
+        segment.minError = segment.maxError = segment.first - predict(segment, sortedVect[segment.first]);
+        for (size_t i = segment.first; i < segment.last; i++) {
+            const double error = i - predict(segment, sortedVect[i]);
+            segment.minError = min(segment.minError, error);
+            segment.maxError = max(segment.maxError, error);
+        }
+    }
+
+public:
+    // (keeps a reference to sortedVect, which must outlive it)
+    explicit LearnedIndex(const vector<int>& sortedVect)
+        : sortedVect(sortedVect), minValue(0), rootSlope(0), isUsingModel(false), expectedProbes(0) {
+        const size_t size = sortedVect.size();
+        if (size == 0)
+            return;
+
+        segments.resize(max<size_t>(size / LEARNED_INDEX_KEYS_PER_SEGMENT, 1));
+        minValue = sortedVect.front();
+        rootSlope = segments.size() / (double(sortedVect.back()) - minValue + 1);
+
+        size_t next = 0;
+        for (size_t s = 0; s < segments.size(); s++) {
+            segments[s].first = next;
+            while (next < size and segment_of(sortedVect[next]) == s)
+                next++;
+            segments[s].last = next;
+            fit(segments[s]);
+
+            const double window = ceil(segments[s].maxError) - floor(segments[s].minError) + 3;
+            const size_t windowSize = min(size_t(window), segments[s].last - segments[s].first + 1);
+            expectedProbes += double(segments[s].last - segments[s].first) * binarySearchProbes(windowSize);
+        }
+        expectedProbes /= size;
+
+        // the model is worth it if it saves a probe or more, counting the read of the segment as one
+        isUsingModel = expectedProbes + 1 < binarySearchProbes(size);
+    }
+
+    bool is_using_model() const { return isUsingModel; }
+    size_t segment_count() const { return segments.size(); }
+
+    // the average number of probes of the last-mile search (or of binary search, in the fallback)
+    double expected_probes() const { return isUsingModel ? expectedProbes : binarySearchProbes(sortedVect.size()); }
+
+    // the position of the first value not less than value (or size()), counting the probes
+    size_t lower_bound(const int value, size_t& probes) const {
+        probes = 0;
+        if (!isUsingModel)
+            return countedLowerBound(sortedVect, 0, sortedVect.size(), value, probes);
+
+        // the answer is within the segment's values, or just after them, and
+        // within the errors of its line (with a position of slack for rounding)
+        const Segment& segment = segments[segment_of(value)];
+        const double prediction = predict(segment, value);
+        const double first = floor(prediction + segment.minError) - 1;
+        const double last = ceil(prediction + segment.maxError) + 2;
+
+        const size_t windowFirst = first <= segment.first ? segment.first : min(size_t(first), segment.last);
+        const size_t windowLast = last >= segment.last ? segment.last : max(size_t(max(last, 0.0)), windowFirst);
+        return countedLowerBound(sortedVect, windowFirst, windowLast, value, probes);
+    }
+
+    size_t lower_bound(const int value) const {
+        size_t probes;
+        return lower_bound(value, probes);
+    }
+
+    // as binarySearch: the position of value, or -1 if it is not there
+    int find(const int value) const {
+        if (!isUsingModel)
+            return binarySearch(value, sortedVect, 0, int(sortedVect.size()) - 1);
+
+        const size_t position = lower_bound(value);
+        return position < sortedVect.size() and sortedVect[position] == value ? int(position) : -1;
+    }
+};
+
+struct SearchCostReport {
+    size_t queryCount;
+    double binarySearchProbes;      // averages per query
+    double interpolationProbes;
+    double learnedIndexProbes;
+    size_t maxInterpolationProbes;
+    size_t maxLearnedIndexProbes;
+    bool isLearnedIndexUsingModel;
+    size_t learnedIndexSegments;
+};
+
+// the probes the searches make for the queries, on average and at most
+SearchCostReport reportSearchCosts(const vector<int>& sortedVect, const vector<int>& queries) {
+    const LearnedIndex index(sortedVect);
+    SearchCostReport report = { queries.size(), 0, 0, 0, 0, 0, index.is_using_model(), index.segment_count() };
+
+    for (const int query : queries) {
+        size_t probes = 0;
+        countedLowerBound(sortedVect, 0, sortedVect.size(), query, probes);
+        report.binarySearchProbes += probes;
+
+        interpolationSearch(query, sortedVect, probes);
+        report.interpolationProbes += probes;
+        report.maxInterpolationProbes = max(report.maxInterpolationProbes, probes);
+
+        index.lower_bound(query, probes);
+        report.learnedIndexProbes += probes;
+        report.maxLearnedIndexProbes = max(report.maxLearnedIndexProbes, probes);
+    }
+
+    if (!queries.empty()) {
+        report.binarySearchProbes /= queries.size();
+        report.interpolationProbes /= queries.size();
+        report.learnedIndexProbes /= queries.size();
+    }
+    return report;
+}
+
+#endif
@@ -0,0 +1,280 @@
+/*
+    Searching benchmark:
+    Runs every search in this directory on sorted arrays of distinct ints,
+    spread uniformly, skewed, or in a cluster with outliers, with sizes
+    going up from 1000 in powers of 10, answering the same
+    SEARCH_QUERY_COUNT random queries (half of them values of the array,
+    half of them random values in its range) with each. It reports the time
+    per query, and how it compares with std::lower_bound, and checks every
+    answer against std::lower_bound.
+    (The batched searches answer all the queries in one call, and the sorted
+    ones get them sorted.) For each array, it also reports how many probes
+    binary search, interpolation search and the learned index make per
+    query (see reportSearchCosts).
+
+    The indexes are built before the timing starts. Each run is repeated
+    until it has taken at least MIN_TIMING_SECONDS.
+
+    Usage: ./SearchingBenchmark.out [max size] [--csv file] [--json file]
+    (10^7 by default, up to 10^8 or so with enough memory; the results also
+    go to the CSV and JSON files, if given)
+
+    (Compile with the -O2 flag when using the CLI.)
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BatchedSearch.h"
+#include "BinarySearch.h"
+#include "EytzingerSearch.h"
+#include "InterpolationSearch.h"
+#include "StaticBTree.h"
+
+using namespace std;
+
+const size_t SEARCH_QUERY_COUNT = 1 << 20;
+const double MIN_TIMING_SECONDS = 0.1;
+
+/*
+    A search answers each query with the position of the first value not
+    less than it (like std::lower_bound), or, if it only finds values, with
+    the position of the query among the values, or their size if it is not
+    there (the values are distinct, so that position is unique). It builds
+    what it needs from the sorted values, and returns how long the queries
+    took, in seconds.
+*/
+struct SearchingAlgorithm {
+    string name;
+    function<double(const vector<int>&, const vector<int>&, vector<size_t>&)> run;
+    bool findsLowerBound;
+};
+
+struct InputDistribution {
+    string name;
+    function<void(vector<int>&, mt19937&)> fill;    // with distinct sorted values
+};
+
+struct BenchmarkResult {
+    size_t size;
+    string distribution;
+    string algorithm;
+    double nanosecondsPerQuery;
+    double speedup;     // over std::lower_bound
+    bool isCorrect;
+};
+
+// runs searchAll until that has taken MIN_TIMING_SECONDS; returns the seconds per run
+template <typename SearchAll>
+double timeSearches(SearchAll searchAll) {
+    double totalSeconds = 0;
+    size_t repetitions = 0;
+
+    while (repetitions == 0 or totalSeconds < MIN_TIMING_SECONDS) {
+        const auto start = chrono::steady_clock::now();
+        searchAll();
+        totalSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        repetitions++;
+    }
+
+    return totalSeconds / repetitions;
+}
+
+// answers the queries one at a time with search; returns the seconds per pass
+template <typename Search>
+double timeQueries(const vector<int>& queries, vector<size_t>& answers, Search search) {
+    return timeSearches([&]() {
+        for (size_t i = 0; i < queries.size(); i++)
+            answers[i] = search(queries[i]);
+    });
+}
+
+const vector<SearchingAlgorithm> ALGORITHMS = {
+    { "std::lower_bound", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        return timeQueries(queries, answers, [&](const int value) {
+            return size_t(lower_bound(sortedValues.begin(), sortedValues.end(), value) - sortedValues.begin());
+        });
+    }, true },
+    { "binarySearch", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        return timeQueries(queries, answers, [&](const int value) {
+            const int position = binarySearch(value, sortedValues, 0, int(sortedValues.size()) - 1);
+            return position == -1 ? sortedValues.size() : size_t(position);
+        });
+    }, false },
+    { "EytzingerIndex", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        const EytzingerIndex index(sortedValues);
+        return timeQueries(queries, answers, [&](const int value) { return index.lower_bound(value); });
+    }, true },
+    { "StaticBTree", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        const StaticBTree tree(sortedValues);
+        return timeQueries(queries, answers, [&](const int value) { return tree.lower_bound(value); });
+    }, true },
+    { "interpolationSearch", [](const vector<int>& sortedValues, const vector<int>& queries,
+                                vector<size_t>& answers) {
+        return timeQueries(queries, answers, [&](const int value) { return interpolationSearch(value, sortedValues); });
+    }, true },
+    { "LearnedIndex", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        const LearnedIndex index(sortedValues);
+        return timeQueries(queries, answers, [&](const int value) { return index.lower_bound(value); });
+    }, true },
+    { "batchLowerBound (scalar)", [](const vector<int>& sortedValues, const vector<int>& queries,
+                                     vector<size_t>& answers) {
+        return timeSearches([&]() { batchLowerBound(sortedValues, queries, answers, false); });
+    }, true },
+    { "batchLowerBound", [](const vector<int>& sortedValues, const vector<int>& queries, vector<size_t>& answers) {
+        return timeSearches([&]() { batchLowerBound(sortedValues, queries, answers); });
+    }, true },
+    // timed on the queries sorted beforehand, as they would come for this one
+    { "sortedQueriesLowerBound", [](const vector<int>& sortedValues, const vector<int>& queries,
+                                    vector<size_t>& answers) {
+        vector<pair<int, size_t>> queryOrder(queries.size());
+        for (size_t i = 0; i < queries.size(); i++)
+            queryOrder[i] = make_pair(queries[i], i);
+        sort(queryOrder.begin(), queryOrder.end());
+
+        vector<int> sortedQueries(queries.size());
+        for (size_t i = 0; i < queries.size(); i++)
+            sortedQueries[i] = queryOrder[i].first;
+
+        vector<size_t> sortedAnswers;
+        const double seconds = timeSearches([&]() {
+            sortedQueriesLowerBound(sortedValues, sortedQueries, sortedAnswers);
+        });
+
+        for (size_t i = 0; i < queries.size(); i++)
+            answers[queryOrder[i].second] = sortedAnswers[i];
+        return seconds;
+    }, true },
+};
+
+const vector<InputDistribution> DISTRIBUTIONS = {
+    { "uniform", [](vector<int>& values, mt19937& generator) {   // random gaps of 1 to 8
+        int value = 0;
+        for (int& sortedValue : values)
+            sortedValue = value += 1 + generator() % 8;
+    } },
+    { "skewed", [](vector<int>& values, mt19937&) {     // growing exponentially, up to about 1.5 * 10^9
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = i + int(exp(double(i) / values.size() * log(1.5e9)));
+    } },
+    // 0, 1, 2, ..., and two outliers, the first one inside the first segment of the learned index's root
+    // model: all the values share that segment, and its line fits them so badly that the index falls back
+    // to binary search. (Beyond about 7 * 10^5 values, distinct ints can't crowd a segment enough for that.)
+    { "outliers", [](vector<int>& values, mt19937&) {
+        const size_t size = values.size();
+        const int outlier = int(1.5e9 / max<size_t>(size / LEARNED_INDEX_KEYS_PER_SEGMENT, 1) / 2);
+        for (size_t i = 0; i + 1 < size; i++)
+            values[i] = i + 2 < size ? int(i) : max(outlier, int(i));
+        values[size - 1] = 1500000000;
+    } },
+};
+
+void writeCSV(const string& path, const vector<BenchmarkResult>& results) {
+    ofstream output(path);
+    output << "size,distribution,algorithm,ns_per_query,speedup,correct\n";
+    for (const BenchmarkResult& result : results)
+        output << result.size << "," << result.distribution << "," << result.algorithm << "," << result.nanosecondsPerQuery << ","
+               << result.speedup << "," << (result.isCorrect ? "true" : "false") << "\n";
+}
+
+void writeJSON(const string& path, const vector<BenchmarkResult>& results) {
+    ofstream output(path);
+    output << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        output << "  { \"size\": " << result.size
+               << ", \"distribution\": \"" << result.distribution << "\""
+               << ", \"algorithm\": \"" << result.algorithm << "\""
+               << ", \"ns_per_query\": " << result.nanosecondsPerQuery
+               << ", \"speedup\": " << result.speedup
+               << ", \"correct\": " << (result.isCorrect ? "true" : "false")
+               << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    output << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = 10000000;
+    string csvPath, jsonPath;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 and i + 1 < argc)
+            csvPath = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 and i + 1 < argc)
+            jsonPath = argv[++i];
+        else
+            maxSize = strtoull(argv[i], nullptr, 10);
+    }
+
+    mt19937 generator(2017);
+    vector<BenchmarkResult> results;
+    bool allCorrect = true;
+
+    cout << left << setw(12) << "size" << setw(12) << "input" << setw(28) << "algorithm"
+         << right << setw(12) << "ns/query" << setw(12) << "speedup" << "\n";
+
+    for (size_t size = 1000; size <= maxSize; size *= 10) {
+        for (const InputDistribution& distribution : DISTRIBUTIONS) {
+            vector<int> sortedValues(size);
+            distribution.fill(sortedValues, generator);
+
+            vector<int> queries(SEARCH_QUERY_COUNT);
+            for (size_t i = 0; i < queries.size(); i++)
+                queries[i] = i % 2 == 0 ? sortedValues[generator() % size]
+                                        : generator() % (sortedValues.back() + 1);
+
+            vector<size_t> lowerBounds(queries.size()), positions(queries.size()), answers(queries.size());
+            double baselineSeconds = 0;
+
+            for (const SearchingAlgorithm& algorithm : ALGORITHMS) {
+                const double seconds = algorithm.run(sortedValues, queries, answers);
+                if (baselineSeconds == 0) {     // std::lower_bound, the first one, is right by definition
+                    baselineSeconds = seconds;
+                    lowerBounds = answers;
+                    for (size_t i = 0; i < queries.size(); i++) {
+                        const bool isFound = answers[i] < size and sortedValues[answers[i]] == queries[i];
+                        positions[i] = isFound ? answers[i] : size;
+                    }
+                }
+
+                BenchmarkResult result;
+                result.size = size;
+                result.distribution = distribution.name;
+                result.algorithm = algorithm.name;
+                result.nanosecondsPerQuery = seconds * 1e9 / queries.size();
+                result.speedup = baselineSeconds / seconds;
+                result.isCorrect = answers == (algorithm.findsLowerBound ? lowerBounds : positions);
+                results.push_back(result);
+                allCorrect = allCorrect and result.isCorrect;
+
+                cout << left << setw(12) << size << setw(12) << distribution.name << setw(28) << algorithm.name
+                     << right << fixed << setw(12) << setprecision(2) << result.nanosecondsPerQuery
+                     << setw(11) << setprecision(2) << result.speedup << "x"
+                     << (result.isCorrect ? "" : "   WRONG!") << endl;
+            }
+
+            const SearchCostReport costs = reportSearchCosts(sortedValues, queries);
+            cout << "    probes per query: binary search " << costs.binarySearchProbes
+                 << ", interpolation " << costs.interpolationProbes << " (at most " << costs.maxInterpolationProbes
+                 << "), learned index " << costs.learnedIndexProbes << " (at most " << costs.maxLearnedIndexProbes
+                 << (costs.isLearnedIndexUsingModel ? ", " + to_string(costs.learnedIndexSegments) + " segments)"
+                                                    : ", fell back to binary search)") << "\n";
+        }
+    }
+
+    if (!csvPath.empty())
+        writeCSV(csvPath, results);
+    if (!jsonPath.empty())
+        writeJSON(jsonPath, results);
+
+    return allCorrect ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/*
+    Various utility functions (for input, memory layout, prefetching etc.)
+    used in programs that implement searching algorithms
+*/
+
+#ifndef SEARCHING_UTILS_H
+#define SEARCHING_UTILS_H
+
+#include <algorithm>    // for is_sorted()
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "../Utils/FastInput.h"
+
+using namespace std;
+
+const size_t CACHE_LINE_BYTES = 64;
+
+// Input utils:
+// (all of the input is read through standardInput(), and the prompts are
+// shown only when it is typed in, so that values can be piped in as well)
+
+// reads the size and the values to search; false (after saying so) if they aren't sorted
+bool getSortedValues(vector<int>& sortedValues) {
+    BufferedReader& input = standardInput();
+
+    size_t size = 0;
+    prompt("Enter the input size : ");
+    input.read(size);
+
+    sortedValues.assign(size, 0);
+    prompt("Enter " + to_string(size) + " integers in ascending order :\n");
+    input.read_all(sortedValues.data(), sortedValues.size());
+
+    if (!is_sorted(sortedValues.begin(), sortedValues.end())) {
+        cout << "The values aren\'t sorted\n";
+        return false;
+    }
+    return true;
+}
+
+/*
+    Answers the values to search for, until the input ends, with where they
+    are among the sorted values, from the lower_bound, upper_bound and
+    contains of index (an EytzingerIndex or a StaticBTree)
+*/
+template <typename Index>
+void answerQueries(const Index& index) {
+    prompt("Enter the values to search for (end the input to stop) :\n");
+    int value;
+    while (standardInput().read(value)) {
+        const size_t lower = index.lower_bound(value), upper = index.upper_bound(value);
+        if (index.contains(value))
+            cout << "Found " << value << " at positions " << (lower + 1) << " to " << upper << "\n";
+        else if (lower < index.size())
+            cout << value << " is not present; the first value greater than it is at position " << (lower + 1) << "\n";
+        else
+            cout << value << " is not present; it is greater than all the values\n";
+    }
+}
+
+// asks for the cache line at address to be loaded, without waiting for it
+// (address need not be valid: a prefetch never faults)
+void prefetch(const uintptr_t address) {
+#ifdef __GNUC__
+    __builtin_prefetch(reinterpret_cast<const void*>(address));
+#else
+    (void) address;
+#endif
+}
+
+/*
+    An array of count values whose first value starts a cache line, so that
+    the search indexes can lay out blocks of values one cache line each.
+    (Non-copyable: it points into its own storage.)
+*/
+template <typename T>
+class CacheAlignedArray {
+private:
+    vector<T> storage;      // with room to move the start up to a cache line boundary
+    T* values;
+    size_t count;
+
+public:
+    explicit CacheAlignedArray(const size_t count = 0)
+        : storage(count + CACHE_LINE_BYTES / sizeof(T)), values(storage.data()), count(count) {
+        const uintptr_t misalignment = reinterpret_cast<uintptr_t>(values) % CACHE_LINE_BYTES;
+        if (misalignment != 0)
+            values += (CACHE_LINE_BYTES - misalignment) / sizeof(T);
+    }
+
+    CacheAlignedArray(const CacheAlignedArray&) = delete;
+    CacheAlignedArray& operator=(const CacheAlignedArray&) = delete;
+    CacheAlignedArray(CacheAlignedArray&&) = default;       // the storage keeps its memory when moved
+    CacheAlignedArray& operator=(CacheAlignedArray&&) = default;
+
+    T& operator[](const size_t i) { return values[i]; }
+    const T& operator[](const size_t i) const { return values[i]; }
+    T* data() { return values; }
+    const T* data() const { return values; }
+    size_t size() const { return count; }
+};
+
+#endif
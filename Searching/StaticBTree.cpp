@@ -0,0 +1,23 @@
+/*
+    Static B-tree (S+tree):
+    Search through a read-only B+ tree over a sorted array, with nodes of one
+    cache line, compared with the value in SIMD (see StaticBTree.h)
+*/
+
+#include <vector>
+
+#include "StaticBTree.h"
+#include "SearchingUtils.h"
+
+using namespace std;
+
+int main() {
+    vector<int> sortedValues;
+    if (!getSortedValues(sortedValues))
+        return 1;
+
+    const StaticBTree index(sortedValues);
+    answerQueries(index);
+
+    return 0;
+}
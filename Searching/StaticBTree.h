@@ -0,0 +1,178 @@
+/*
+    Static B-tree (S+tree):
+    A read-only B+ tree over a sorted array, built once, with nodes of
+    BTREE_NODE_KEYS (16) keys, one cache line of ints each. The leaves are
+    the sorted values themselves, 16 to a node (the last one padded with
+    INT_MAX), so the position of a key in its leaf is its position in the
+    sorted array. Above them, each node has 17 children, and its key j is
+    the smallest value under its child j + 1. The tree is implicit: the
+    children of node k are nodes 17k to 17k + 16 of the layer below, and
+    the layers are stored one after another, so it needs no pointers.
+
+    A search goes down one node per layer, and the child to take is the
+    number of keys of the node less than the value (as they are in order).
+    With AVX2, that is two compares of 8 keys each with the value, whose
+    masks are counted with movemask and popcount: no branches, and one cache
+    line per layer, where binarySearch loads one per comparison. Without
+    AVX2 (checked at runtime), the keys are counted by a scalar loop.
+
+    For 10^8 values, that is 7 layers, instead of the 27 levels of binary
+    search, and the upper ones are small enough to stay cached.
+
+    Usage:
+        StaticBTree tree(sortedValues);
+        tree.lower_bound(value);    // the position of the first value not less than value
+        tree.contains(value);
+
+    Time complexity:
+    O(n) to build the tree, and O(log(n)) per search (log base 17), where n
+    is the number of values
+
+    Space complexity:
+    O(n), for the leaves, and about n / 16 more for the nodes above them
+*/
+
+#ifndef STATIC_BTREE_H
+#define STATIC_BTREE_H
+
+#include <climits>
+#include <vector>
+
+#include "SearchingUtils.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STATIC_BTREE_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+const size_t BTREE_NODE_KEYS = CACHE_LINE_BYTES / sizeof(int);
+const size_t BTREE_NODE_CHILDREN = BTREE_NODE_KEYS + 1;
+
+class StaticBTree {
+private:
+    CacheAlignedArray<int> keys;    // the nodes of each layer, from the leaves up
+    vector<size_t> layerOffsets;    // where each layer starts in keys
+    size_t count;
+    bool hasAVX2;
+
+    size_t layer_count() const { return layerOffsets.size(); }
+
+    // the number of keys of node that come before value (are less than it, or not greater if isStrict)
+    static size_t rank_scalar(const int* node, const int value, const bool isStrict) {
+        size_t rank = 0;
+        for (size_t i = 0; i < BTREE_NODE_KEYS; i++)
+            rank += isStrict ? node[i] <= value : node[i] < value;
+        return rank;
+    }
+
+    // the position of the first value greater than value (or not less than it, unless isStrict)
+    size_t descend_scalar(const int value, const bool isStrict) const {
+        size_t k = 0;
+        for (size_t layer = layer_count(); layer-- > 1; ) {
+            const size_t child = rank_scalar(&keys[layerOffsets[layer] + k * BTREE_NODE_KEYS], value, isStrict);
+            k = k * BTREE_NODE_CHILDREN + child;
+        }
+
+        const size_t position = k * BTREE_NODE_KEYS + rank_scalar(&keys[k * BTREE_NODE_KEYS], value, isStrict);
+        return position < count ? position : count;
+    }
+
+#ifdef STATIC_BTREE_X86
+
+    __attribute__((target("avx2,popcnt")))
+    static size_t rank_AVX2(const int* node, const __m256i values, const bool isStrict) {
+        const __m256i keys1 = _mm256_load_si256((const __m256i*) node);
+        const __m256i keys2 = _mm256_load_si256((const __m256i*) (node + 8));
+
+        // the keys less than value, or if isStrict, the keys greater than it, which leave the rest
+        const __m256i compared1 = isStrict ? _mm256_cmpgt_epi32(keys1, values) : _mm256_cmpgt_epi32(values, keys1);
+        const __m256i compared2 = isStrict ? _mm256_cmpgt_epi32(keys2, values) : _mm256_cmpgt_epi32(values, keys2);
+        const unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(compared1))
+                              | _mm256_movemask_ps(_mm256_castsi256_ps(compared2)) << 8;
+
+        const size_t rank = _mm_popcnt_u32(mask);
+        return isStrict ? BTREE_NODE_KEYS - rank : rank;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    size_t descend_AVX2(const int value, const bool isStrict) const {
+        const __m256i values = _mm256_set1_epi32(value);
+
+        size_t k = 0;
+        for (size_t layer = layer_count(); layer-- > 1; ) {
+            const size_t child = rank_AVX2(&keys[layerOffsets[layer] + k * BTREE_NODE_KEYS], values, isStrict);
+            k = k * BTREE_NODE_CHILDREN + child;
+        }
+
+        const size_t position = k * BTREE_NODE_KEYS + rank_AVX2(&keys[k * BTREE_NODE_KEYS], values, isStrict);
+        return position < count ? position : count;
+    }
+
+#endif
+
+    size_t descend(const int value, const bool isStrict) const {
+#ifdef STATIC_BTREE_X86
+        if (hasAVX2)
+            return descend_AVX2(value, isStrict);
+#endif
+        return descend_scalar(value, isStrict);
+    }
+
+public:
+    explicit StaticBTree(const vector<int>& sortedValues) : count(sortedValues.size()), hasAVX2(false) {
+        // nodes per layer, from the leaves up to the root
+        vector<size_t> layerNodes(1, (count + BTREE_NODE_KEYS - 1) / BTREE_NODE_KEYS);
+        if (layerNodes[0] == 0)
+            layerNodes[0] = 1;
+        while (layerNodes.back() > 1)
+            layerNodes.push_back((layerNodes.back() + BTREE_NODE_CHILDREN - 1) / BTREE_NODE_CHILDREN);
+
+        size_t keyCount = 0;
+        for (const size_t nodes : layerNodes) {
+            layerOffsets.push_back(keyCount);
+            keyCount += nodes * BTREE_NODE_KEYS;
+        }
+        keys = CacheAlignedArray<int>(keyCount);
+
+        for (size_t i = 0; i < layerNodes[0] * BTREE_NODE_KEYS; i++)
+            keys[i] = i < count ? sortedValues[i] : INT_MAX;
+
+        // key j of node k is the smallest value under child j + 1: the first
+        // value of the leftmost leaf under it (or INT_MAX, if there is none)
+        size_t leavesPerChild = 1;
+        for (size_t layer = 1; layer < layer_count(); layer++) {
+            for (size_t k = 0; k < layerNodes[layer]; k++) {
+                for (size_t j = 0; j < BTREE_NODE_KEYS; j++) {
+                    const size_t leaf = (k * BTREE_NODE_CHILDREN + j + 1) * leavesPerChild;
+                    keys[layerOffsets[layer] + k * BTREE_NODE_KEYS + j] =
+                        leaf * BTREE_NODE_KEYS < count ? sortedValues[leaf * BTREE_NODE_KEYS] : INT_MAX;
+                }
+            }
+            leavesPerChild *= BTREE_NODE_CHILDREN;
+        }
+
+#ifdef STATIC_BTREE_X86
+        hasAVX2 = __builtin_cpu_supports("avx2") and __builtin_cpu_supports("popcnt");
+#endif
+    }
+
+    size_t size() const { return count; }
+
+    // the position of the first value not less than value in the sorted array, or size() if there is none
+    size_t lower_bound(const int value) const { return descend(value, false); }
+
+    // the position of the first value greater than value in the sorted array, or size() if there is none
+    size_t upper_bound(const int value) const {
+        // (the padding is INT_MAX too, and must not be descended into)
+        return value == INT_MAX ? count : descend(value, true);
+    }
+
+    bool contains(const int value) const {
+        const size_t position = lower_bound(value);
+        return position < count and keys[position] == value;
+    }
+};
+
+#endif
@@ -7,34 +7,15 @@
 #include <iostream>
 #include <vector>
 
+#include "BubbleSort.h"
 #include "SortingUtils.h"
 
 using namespace std;
 
-void bubbleSort(vector<int>& values, const int order, const bool toShowState) {
-    bool swapped;
-    size_t i, j;
-
-    for (i = 0; i < values.size() - 1; i++) {
-        swapped = false;
-        for (j = 0; i + j < values.size() - 1; j++) {
-            // 'order' is -1 for descending, so the inequality is reversed:
-            if (order * values[j] > order * values[j+1]) {
-                swap(values[j], values[j+1]);
-                swapped = true;
-
-                if (toShowState)
-                    displayState(values);
-            }
-        }
-        if (!swapped)
-            break;
-    }
-}
-
 int main() {
     size_t size;
-    getInputSize(size);
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
 
     vector<int> values(size);
     getInputValues(values, size);
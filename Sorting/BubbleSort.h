@@ -0,0 +1,43 @@
+/*
+    Bubble sort (also known as sinking sort):
+    A simple sorting algorithm that repeatedly compares pairs of adjacent
+    elements and swaps their positions if they are in the wrong order
+
+    Time complexity:
+    O(n^2), where n is the number of values to sort (O(n) if they are already
+    sorted)
+
+    Space complexity:
+    O(1)
+*/
+
+#ifndef BUBBLE_SORT_H
+#define BUBBLE_SORT_H
+
+#include <vector>
+
+#include "SortingUtils.h"
+
+using namespace std;
+
+void bubbleSort(vector<int>& values, const int order, const bool toShowState) {
+    bool swapped;
+    size_t i, j;
+
+    for (i = 0; i + 1 < values.size(); i++) {
+        swapped = false;
+        for (j = 0; i + j + 1 < values.size(); j++) {
+            if (comesBefore(values[j+1], values[j], order)) {
+                swap(values[j], values[j+1]);
+                swapped = true;
+
+                if (toShowState)
+                    displayState(values);
+            }
+        }
+        if (!swapped)
+            break;
+    }
+}
+
+#endif
@@ -6,74 +6,23 @@
 
     Time complexity is O(n + k), where n is the number of elements in the input
     array and k is the range of input.
+
+    (Compile with the -pthread flag when using the CLI, for the parallel variant.)
 */
 
 #include <iostream>
 #include <vector>
 
+#include "CountingSort.h"
+#include "ParallelCountingSort.h"
 #include "SortingUtils.h"
 
 using namespace std;
 
-void counting_sort(vector<int> &values, const int order, const bool to_show_state) {
-
-    int min_value = values[0];
-    int max_value = values[0];
-
-    // find minimum and maximum values in input vector
-    for (const int &value : values) {
-        if (value < min_value)
-            min_value = value;
-        else if (value > max_value)
-            max_value = value;
-    }
-
-    // calculate unique values in input vector
-    const int unique_values = max_value - min_value + 1;
-
-    // calculate frequencies of each unique value in input vector
-    // freq[0] is number of min_value occurencies and so on
-    vector<int> freq(unique_values, 0);
-    for (const int &value : values) {
-        ++freq[value - min_value];
-    }
-
-    // start and end indices, for calculating cumulative frequency
-    int start = 1;
-    int end = freq.size();
-
-    // if order is reversed, the indices are reversed too
-    if (order == -1) {      // 'order' is -1 for descending, 1 for ascending
-        start = freq.size() - 2;
-        end = -1;
-    }
-
-    // calculate cumulative frequency
-    // freq[i] will now be the number of elements in the sorted array that are
-    // less than or equal to value[i]
-    for (int i = start; i != end; i += order) {
-        freq[i] += freq[i - order];
-    }
-
-    // place values in sorted order by iterating input vector in reversed order,
-    // to maintain sorting stability
-    vector<int> sorted(values.size());
-    int value;
-    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
-        value = *iter;
-        sorted[freq[value - min_value] - 1] = value;
-        --freq[value - min_value];
-
-        if (to_show_state)
-            displayState(sorted);
-    }
-
-    values.assign(sorted.begin(), sorted.end());
-}
-
 int main() {
     size_t size;
-    getInputSize(size);
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
 
     vector<int> values(size);
     getInputValues(values, size);
@@ -85,7 +34,16 @@ int main() {
     bool toShowState;
     getWhetherToShowState(toShowState);
 
-    counting_sort(values, order, toShowState);
+    size_t variant;
+    getVariant(variant, { "counting sort, O(range of values) memory", "LSD radix sort, 11-bit digits",
+                          "parallel counting sort, on all hardware threads (never shows state)" });
+
+    if (variant == 1)
+        radix_sort(values, order, toShowState);
+    else if (variant == 2)
+        parallel_counting_sort(values, order);
+    else
+        counting_sort(values, order, toShowState);
 
     cout << "\nThe values in " << orderText << " order are :\n";
     displayState(values);
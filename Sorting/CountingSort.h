@@ -0,0 +1,161 @@
+/*
+    Counting sort (stable):
+    An integer sorting algorithm that operates by counting the number of objects
+    that have each distinct key value, and using arithmetic on those counts
+    to determine the positions of each key value in the output sequence.
+
+    Time complexity is O(n + k), where n is the number of elements in the input
+    array and k is the range of input. The pass that finds the range (see
+    RangeScan.h) also returns early when the values are sorted already. A
+    range larger than max(n, MIN_COUNTING_RANGE) is not worth its memory
+    (INT_MIN and INT_MAX alone would need 2^32 counts), so such values are
+    radix sorted instead.
+
+    Radix sort (LSD, stable):
+    Counting sort applied to one RADIX_BITS-bit digit of the values at a time,
+    from the least significant digit to the most significant one. The sign bit
+    is flipped first, so that negative values sort before positive ones as
+    unsigned digits. The histograms of all the digits are built in a single
+    pass over the values, and a digit in which all the values agree is
+    skipped. Unlike counting sort, it never needs memory for the whole range
+    of the values, so outliers like INT_MIN and INT_MAX cost nothing extra.
+
+    Time complexity is O(d * (n + 2^b)), where n is the number of elements,
+    b is RADIX_BITS and d = 32 / b is the number of digits. Space complexity
+    is O(n + d * 2^b).
+*/
+
+#ifndef COUNTING_SORT_H
+#define COUNTING_SORT_H
+
+#include <algorithm>    // for max()
+#include <cstdint>
+#include <vector>
+
+#include "RangeScan.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+const size_t MIN_COUNTING_RANGE = 1 << 16;  // ranges up to max(n, this) are worth counting, larger ones are not
+
+// 3 digits, so 3 passes instead of the 4 of bytes; each histogram is 16 KiB (of size_t
+// counts), so the one a pass scatters with stays in the L1 cache, and all 3 (48 KiB) in L2
+const int RADIX_BITS = 11;
+const int RADIX_DIGITS = (32 + RADIX_BITS - 1) / RADIX_BITS;
+const size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+
+// calculate cumulative frequency, in the given order:
+// freq[i] will now be the number of elements in the sorted array that
+// come before or with the i-th key
+template <typename Count>
+void cumulate_frequencies(vector<Count> &freq, const int order) {
+    // start and end indices, for calculating cumulative frequency
+    long long start = 1;
+    long long end = freq.size();
+
+    // if order is reversed, the indices are reversed too
+    if (order == -1) {      // 'order' is -1 for descending, 1 for ascending
+        start = (long long) freq.size() - 2;
+        end = -1;
+    }
+
+    for (long long i = start; i != end; i += order) {
+        freq[i] += freq[i - order];
+    }
+}
+
+void radix_sort(vector<int> &values, const int order, const bool to_show_state);
+
+void counting_sort(vector<int> &values, const int order, const bool to_show_state) {
+    if (values.empty())
+        return;
+
+    // find minimum and maximum values in input vector, and stop there if it
+    // turns out to be sorted already
+    const RangeScan scan = scanRange(values);
+    if (sortIfMonotonic(values, scan, order))
+        return;
+
+    const int min_value = scan.minValue;
+    const int max_value = scan.maxValue;
+
+    // calculate unique values in input vector (in 64 bits, since the range of
+    // an int does not fit in an int)
+    const size_t unique_values = (long long) max_value - min_value + 1;
+    if (unique_values > max(values.size(), MIN_COUNTING_RANGE)) {
+        radix_sort(values, order, to_show_state);
+        return;
+    }
+
+    // calculate frequencies of each unique value in input vector
+    // freq[0] is number of min_value occurencies and so on
+    vector<int> freq(unique_values, 0);
+    SortingInstrumentation::allocated(freq.size() * sizeof(int));
+    for (const int &value : values) {
+        ++freq[(long long) value - min_value];
+    }
+
+    cumulate_frequencies(freq, order);
+
+    // place values in sorted order by iterating input vector in reversed order,
+    // to maintain sorting stability
+    vector<int> sorted(values.size());
+    SortingInstrumentation::allocated(sorted.size() * sizeof(int));
+    SortingInstrumentation::moved(2 * sorted.size());   // into sorted, and back
+    int value;
+    for (auto iter = values.rbegin(); iter != values.rend(); ++iter) {
+        value = *iter;
+        sorted[freq[(long long) value - min_value] - 1] = value;
+        --freq[(long long) value - min_value];
+
+        if (to_show_state)
+            displayState(sorted);
+    }
+
+    values.assign(sorted.begin(), sorted.end());
+}
+
+// the digit-th RADIX_BITS-bit digit of the key of value, with the sign bit flipped
+// so that the keys of negative values come before those of positive ones
+uint32_t radix_digit(const int value, const int digit) {
+    const uint32_t key = uint32_t(value) ^ 0x80000000u;
+    return (key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+}
+
+void radix_sort(vector<int> &values, const int order, const bool to_show_state) {
+    if (values.empty() or sortIfMonotonic(values, scanRange(values), order))
+        return;
+
+    // the histograms of all digits, in a single pass
+    vector<vector<size_t>> freq(RADIX_DIGITS, vector<size_t>(RADIX_BUCKETS, 0));
+    SortingInstrumentation::allocated(RADIX_DIGITS * RADIX_BUCKETS * sizeof(size_t));
+    for (const int &value : values) {
+        const uint32_t key = uint32_t(value) ^ 0x80000000u;
+        for (int digit = 0; digit < RADIX_DIGITS; digit++)
+            ++freq[digit][(key >> (digit * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+    }
+
+    vector<int> sorted(values.size());
+    SortingInstrumentation::allocated(sorted.size() * sizeof(int));
+    for (int digit = 0; digit < RADIX_DIGITS; digit++) {
+        // if all the values have the same digit here, this pass would not move anything
+        if (freq[digit][radix_digit(values[0], digit)] == values.size())
+            continue;
+
+        cumulate_frequencies(freq[digit], order);
+
+        // place values in sorted order of this digit by iterating the input
+        // in reversed order, to maintain sorting stability
+        for (auto iter = values.rbegin(); iter != values.rend(); ++iter)
+            sorted[--freq[digit][radix_digit(*iter, digit)]] = *iter;
+        SortingInstrumentation::moved(values.size());
+
+        values.swap(sorted);    // the sorted values are the input of the next pass
+
+        if (to_show_state)
+            displayState(values);
+    }
+}
+
+#endif
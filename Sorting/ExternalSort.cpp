@@ -0,0 +1,60 @@
+/*
+    External merge sort:
+    Sorts a file of ints that is too large to fit in memory, by sorting chunks
+    that fit in a memory budget, spilling them to temporary files, and merging
+    those with a loser tree (see ExternalSort.h).
+*/
+
+#include <iostream>
+#include <string>
+
+#include "ExternalSort.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+void getFileNames(string& inputFile, string& outputFile) {
+    prompt("Enter the name of the file to sort : ");
+    standardInput().read_line(inputFile);
+    prompt("Enter the name of the file to write the sorted values to : ");
+    standardInput().read_line(outputFile);
+}
+
+void getWhetherBinary(bool& isBinary) {
+    string answer;
+    prompt("\nFile format?\n[B]inary int32 / [t]ext : ");
+    standardInput().read_line(answer);
+
+    isBinary = !(answer[0] == 't' or answer[0] == 'T');
+}
+
+void getMemoryBudget(size_t& memoryBudget) {
+    string answer;
+    prompt("\nMemory budget in MiB? (default " + to_string(memoryBudget >> 20) + ") : ");
+    standardInput().read_line(answer);
+
+    if (!answer.empty() and stoull(answer) > 0)
+        memoryBudget = size_t(stoull(answer)) << 20;
+}
+
+int main() {
+    string inputFile, outputFile;
+    getFileNames(inputFile, outputFile);
+
+    ExternalSortOptions options;
+    getWhetherBinary(options.isBinary);
+    getMemoryBudget(options.memoryBudget);
+
+    string orderText;
+    getOrder(options.order, orderText);
+
+    string error;
+    if (!externalSort(inputFile, outputFile, options, error)) {
+        cout << "\nCould not sort: " << error << "\n";
+        return 1;
+    }
+
+    cout << "\nThe values in " << orderText << " order have been written to " << outputFile << "\n";
+
+    return 0;
+}
@@ -0,0 +1,257 @@
+/*
+    External merge sort:
+    Sorts a file of ints that may be much larger than the available memory.
+    1. The input (raw binary int32 values, or whitespace separated text) is
+       read in chunks that fit in the memory budget, and each chunk is sorted
+       in memory with blockQuickSort.
+    2. Each sorted chunk is spilled to a temporary run file.
+    3. The runs are merged k at a time with a loser tree, each run being read
+       through a large sequential buffer, until one run is left, which is
+       written to the output (in the same format as the input). If there
+       are too many runs for the budget to give each of them a buffer of at
+       least MIN_MERGE_BUFFER_BYTES, groups of runs are merged into longer
+       runs first.
+    Equal values keep the order of their runs, and the temporary files are
+    removed when done.
+
+    Time complexity:
+    O(n * log(n)) comparisons, and O(n * (1 + log_k(n / M))) values of I/O,
+    where n is the number of values, M is the number of values that fit in the
+    memory budget, and k is the number of runs merged at a time
+
+    Space complexity:
+    O(M) memory, and O(n) temporary disk space
+*/
+
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "QuickSort.h"
+#include "SortingUtils.h"
+#include "../Utils/BufferedWriter.h"
+#include "../Utils/FastInput.h"
+
+using namespace std;
+
+static_assert(sizeof(int) == 4, "external sort works on int32 records");
+
+const size_t MIN_MERGE_BUFFER_BYTES = 1 << 20;  // the smallest read buffer worth merging through
+
+struct ExternalSortOptions {
+    size_t memoryBudget = size_t(256) << 20;    // bytes
+    bool isBinary = true;   // raw int32 values, or else whitespace separated text
+    int order = 1;          // -1 for descending, 1 for ascending
+    string temporaryPrefix;     // path prefix for run files, the output file name by default
+};
+
+// reads a run file sequentially through a buffer
+class RunReader {
+private:
+    FILE* file;
+    vector<int> buffer;
+    size_t position, count;
+
+    void refill() {
+        count = fread(buffer.data(), sizeof(int), buffer.size(), file);
+        position = 0;
+    }
+
+public:
+    RunReader(FILE* file, const size_t bufferValues) : file(file), buffer(max<size_t>(bufferValues, 1)) {
+        refill();
+    }
+
+    bool is_exhausted() const { return position == count; }
+    int head() const { return buffer[position]; }
+
+    void advance() {
+        if (++position == count)
+            refill();
+    }
+};
+
+/*
+    Loser tree over k runs: each internal node holds the run that lost the
+    comparison there, and losers[0] holds the overall winner, so replacing
+    the winner's value takes only log(k) comparisons on its path to the root.
+*/
+class LoserTree {
+private:
+    vector<RunReader>& runs;
+    vector<size_t> losers;
+    const size_t runCount;
+    const int order;
+
+    // whether run a's head should come out after run b's (index runCount is a sentinel that beats everything)
+    bool comes_after(const size_t a, const size_t b) const {
+        if (a == runCount or b == runCount)
+            return b == runCount and a != runCount;
+        if (runs[a].is_exhausted() or runs[b].is_exhausted())
+            return runs[a].is_exhausted() and (!runs[b].is_exhausted() or a > b);
+        if (runs[a].head() != runs[b].head())
+            return comesBefore(runs[b].head(), runs[a].head(), order);
+        return a > b;   // equal values come out in the order of their runs
+    }
+
+    // replays the matches on the path from run's leaf to the root
+    void replay(size_t run) {
+        for (size_t node = (run + runCount) / 2; node > 0; node /= 2)
+            if (comes_after(run, losers[node]))
+                swap(run, losers[node]);
+        losers[0] = run;
+    }
+
+public:
+    LoserTree(vector<RunReader>& runs, const int order)
+        : runs(runs), losers(runs.size(), runs.size()), runCount(runs.size()), order(order) {
+        for (size_t run = runCount; run-- > 0; )
+            replay(run);
+    }
+
+    bool is_empty() const { return runCount == 0 or runs[losers[0]].is_exhausted(); }
+
+    int pop() {
+        const size_t winner = losers[0];
+        const int value = runs[winner].head();
+        runs[winner].advance();
+        replay(winner);
+        return value;
+    }
+};
+
+// fills values with upto values.size() ints from the input (read through textInput if it is text),
+// and returns how many were read; sets error if the text has something that is not an int
+size_t readChunk(FILE* input, BufferedReader& textInput, vector<int>& values, const bool isBinary,
+                 const string& inputFile, string& error) {
+    if (isBinary)
+        return fread(values.data(), sizeof(int), values.size(), input);
+
+    const size_t count = textInput.read_all(values.data(), values.size());
+    // read_all stops early at the end of the input, or at a token it can't read, which is still there
+    if (count < values.size() and textInput.skip_whitespace())
+        error = "malformed value in " + inputFile;
+    return count;
+}
+
+// merges the given run files into the output file, and removes them
+bool mergeRunFiles(const vector<string>& runFiles, const string& outputFile, const bool isBinary,
+                   const size_t memoryBudget, const int order, string& error) {
+    // one read buffer per run, and one for the output
+    const size_t bufferValues = memoryBudget / (runFiles.size() + 1) / sizeof(int);
+
+    vector<FILE*> files;
+    vector<RunReader> runs;
+    for (const string& runFile : runFiles) {
+        files.push_back(fopen(runFile.c_str(), "rb"));
+        if (files.back() == nullptr) {
+            error = "could not open " + runFile;
+            files.pop_back();
+            break;
+        }
+        runs.emplace_back(files.back(), bufferValues);
+    }
+
+    FILE* output = error.empty() ? fopen(outputFile.c_str(), isBinary ? "wb" : "w") : nullptr;
+    if (error.empty() and output == nullptr)
+        error = "could not open " + outputFile;
+
+    if (error.empty()) {
+        LoserTree tree(runs, order);
+
+        if (isBinary) {
+            vector<int> outputBuffer(max<size_t>(bufferValues, 1));
+            size_t used = 0;
+            while (!tree.is_empty()) {
+                outputBuffer[used++] = tree.pop();
+                if (used == outputBuffer.size()) {
+                    fwrite(outputBuffer.data(), sizeof(int), used, output);
+                    used = 0;
+                }
+            }
+            fwrite(outputBuffer.data(), sizeof(int), used, output);
+        } else {
+            BufferedWriter writer(output, max<size_t>(bufferValues * sizeof(int), MAX_INTEGER_LENGTH + 1));
+            while (!tree.is_empty())
+                writer << tree.pop() << '\n';
+        }
+
+        if (ferror(output))
+            error = "could not write to " + outputFile;
+    }
+
+    if (output != nullptr)
+        fclose(output);
+    for (FILE* file : files)
+        fclose(file);
+    for (const string& runFile : runFiles)
+        remove(runFile.c_str());
+
+    return error.empty();
+}
+
+// sorts the ints in inputFile into outputFile; returns false, with the reason in error, if it fails
+bool externalSort(const string& inputFile, const string& outputFile, const ExternalSortOptions& options, string& error) {
+    error.clear();
+    const string prefix = (options.temporaryPrefix.empty() ? outputFile : options.temporaryPrefix) + ".run";
+    size_t nextRunId = 0;
+
+    FILE* input = fopen(inputFile.c_str(), options.isBinary ? "rb" : "r");
+    if (input == nullptr) {
+        error = "could not open " + inputFile;
+        return false;
+    }
+
+    // 1 and 2: sort chunks that fit in memory, and spill them as runs
+    vector<string> runFiles;
+    {
+        BufferedReader textInput(input, options.isBinary ? 1 : DEFAULT_READ_BUFFER_SIZE);
+        vector<int> chunk(max<size_t>(options.memoryBudget / sizeof(int), 1));
+        size_t count;
+        while (error.empty() and (count = readChunk(input, textInput, chunk, options.isBinary, inputFile, error)) > 0) {
+            if (!error.empty())
+                break;
+            chunk.resize(count);
+            blockQuickSort(chunk, options.order, false);
+
+            runFiles.push_back(prefix + to_string(nextRunId++));
+            FILE* run = fopen(runFiles.back().c_str(), "wb");
+            if (run == nullptr or fwrite(chunk.data(), sizeof(int), count, run) != count)
+                error = "could not write " + runFiles.back();
+            if (run != nullptr)
+                fclose(run);
+
+            chunk.resize(max<size_t>(options.memoryBudget / sizeof(int), 1));
+        }
+    }
+    fclose(input);
+
+    // 3: merge groups of runs into longer runs, while there are too many to merge at once
+    const size_t maxRunsPerMerge = max<size_t>(options.memoryBudget / MIN_MERGE_BUFFER_BYTES, 3) - 1;
+    while (error.empty() and runFiles.size() > maxRunsPerMerge) {
+        vector<string> mergedRunFiles;
+        size_t first = 0;
+        for (; error.empty() and first < runFiles.size(); first += maxRunsPerMerge) {
+            const vector<string> group(runFiles.begin() + first,
+                                       runFiles.begin() + min(first + maxRunsPerMerge, runFiles.size()));
+            mergedRunFiles.push_back(prefix + to_string(nextRunId++));
+            mergeRunFiles(group, mergedRunFiles.back(), true, options.memoryBudget, options.order, error);
+        }
+        // after a failed merge, the runs not merged yet are still there, to be removed with the rest
+        mergedRunFiles.insert(mergedRunFiles.end(), runFiles.begin() + min(first, runFiles.size()), runFiles.end());
+        runFiles.swap(mergedRunFiles);
+    }
+
+    if (error.empty())
+        return mergeRunFiles(runFiles, outputFile, options.isBinary, options.memoryBudget, options.order, error);
+
+    for (const string& runFile : runFiles)
+        remove(runFile.c_str());
+    return false;
+}
+
+#endif
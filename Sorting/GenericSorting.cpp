@@ -0,0 +1,64 @@
+/*
+    Generic sorting:
+    Sorts real numbers with the generic sorts of GenericSorting.h, which work
+    on any type, to show them on something other than int. The order is
+    picked as a comparator (Ascending or Descending), not as a number to
+    multiply by.
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "GenericSorting.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+template <typename Compare>
+void sortValues(vector<double>& values, const size_t variant, Compare comp) {
+    switch (variant) {
+        case 1: merge_sort(values.begin(), values.end(), comp); break;
+        case 2: insertion_sort(values.begin(), values.end(), comp); break;
+        case 3: selection_sort(values.begin(), values.end(), comp); break;
+        case 4: bubble_sort(values.begin(), values.end(), comp); break;
+        case 5:
+            // stable, so the values with the same integer part keep their input order
+            counting_sort(values.begin(), values.end(), [](const double value) { return (long long) value; },
+                          comp(1, 0));
+            break;
+        default: quick_sort(values.begin(), values.end(), comp);
+    }
+}
+
+int main() {
+    size_t size;
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
+
+    vector<double> values(size);
+    prompt("\nEnter " + to_string(size) + " real numbers :\n");
+    for (double& value : values)
+        if (!standardInput().read(value))
+            value = 0;
+    standardInput().skip_line();
+
+    int order;
+    string orderText;
+    getOrder(order, orderText);
+
+    size_t variant;
+    getVariant(variant, { "quick_sort", "merge_sort", "insertion_sort", "selection_sort", "bubble_sort",
+                          "counting_sort, by integer part only" });
+
+    if (order == 1)
+        sortValues(values, variant, Ascending());
+    else
+        sortValues(values, variant, Descending());
+
+    cout << "\nThe values in " << orderText << " order are :\n";
+    for (const double& value : values)
+        cout << value << " ";
+    cout << "\n";
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+/*
+    Generic sorting:
+    Header-only versions of the sorts in this directory for any type, over
+    any random-access range (vectors, arrays, pointers, ...). The order is
+    given by a comparator, a template parameter like the one of std::sort:
+    comp(a, b) tells whether a must come before b. Since the comparator's
+    type is known at compile time, comparisons like less<T>, greater<T>,
+    Ascending and Descending are inlined, and there is no runtime 'order'
+    to multiply by (which overflows for INT_MIN). A projection sorts by a
+    part of each value: by_key(key, comp) compares key(a) with key(b).
+
+    Usage:
+        quick_sort(values.begin(), values.end());                          // ascending
+        merge_sort(values.begin(), values.end(), Descending());
+        merge_sort(points.begin(), points.end(), by_key([](const Point& p) { return p.x; }));
+        counting_sort(records.begin(), records.end(), [](const Record& r) { return r.id; });
+
+    quick_sort is an introsort, like introSort in QuickSort.h; merge_sort and
+    counting_sort are stable. The complexities are given with each sort.
+*/
+
+#ifndef GENERIC_SORTING_H
+#define GENERIC_SORTING_H
+
+#include <algorithm>    // for make_heap(), sort_heap(), iter_swap()
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+const ptrdiff_t GENERIC_INSERTION_SORT_CUTOFF = 24;     // ranges up to this long are insertion sorted
+const unsigned long long GENERIC_MIN_COUNTING_RANGE = 1 << 16;  // key ranges up to max(n, this) are counted
+
+// comparators for any type with a < operator, without naming the type
+struct Ascending {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+struct Descending {
+    template <typename T>
+    bool operator()(const T& a, const T& b) const { return b < a; }
+};
+
+// compares values by their keys
+template <typename Key, typename Compare>
+struct ProjectedCompare {
+    Key key;
+    Compare compare;
+
+    template <typename T>
+    bool operator()(const T& a, const T& b) const { return compare(key(a), key(b)); }
+};
+
+template <typename Key, typename Compare = Ascending>
+ProjectedCompare<Key, Compare> by_key(Key key, Compare compare = Compare()) {
+    return ProjectedCompare<Key, Compare> { key, compare };
+}
+
+/*
+    Insertion sort:
+    Time complexity O(n^2), O(n) on sorted input; space complexity O(1)
+*/
+template <typename RandomIt, typename Compare = Ascending>
+void insertion_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    if (last - first < 2)
+        return;
+
+    for (RandomIt next = first + 1; next != last; ++next) {
+        auto value = move(*next);
+
+        // shift the sorted values that must come after value to make room for it
+        RandomIt hole = next;
+        while (hole != first and comp(value, *(hole - 1))) {
+            *hole = move(*(hole - 1));
+            --hole;
+        }
+        *hole = move(value);
+    }
+}
+
+/*
+    Selection sort:
+    Time complexity O(n^2); space complexity O(1)
+*/
+template <typename RandomIt, typename Compare = Ascending>
+void selection_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    for (; last - first > 1; ++first) {
+        RandomIt extreme = first;   // the value that must come first among [first, last)
+        for (RandomIt next = first + 1; next != last; ++next)
+            if (comp(*next, *extreme))
+                extreme = next;
+
+        if (extreme != first)
+            iter_swap(first, extreme);
+    }
+}
+
+/*
+    Bubble sort:
+    Time complexity O(n^2), O(n) on sorted input; space complexity O(1)
+*/
+template <typename RandomIt, typename Compare = Ascending>
+void bubble_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    bool swapped = true;
+    for (; swapped and last - first > 1; --last) {
+        swapped = false;
+        for (RandomIt next = first; next + 1 != last; ++next) {
+            if (comp(*(next + 1), *next)) {
+                iter_swap(next, next + 1);
+                swapped = true;
+            }
+        }
+    }
+}
+
+// moves the median of *a, *b and *c to *result
+template <typename RandomIt, typename Compare>
+void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c))
+            iter_swap(result, b);
+        else if (comp(*a, *c))
+            iter_swap(result, c);
+        else
+            iter_swap(result, a);
+    } else if (comp(*a, *c)) {
+        iter_swap(result, a);
+    } else if (comp(*b, *c)) {
+        iter_swap(result, c);
+    } else {
+        iter_swap(result, b);
+    }
+}
+
+template <typename RandomIt, typename Compare>
+void quick_sort_loop(RandomIt first, RandomIt last, size_t depthLimit, Compare comp) {
+    while (last - first > GENERIC_INSERTION_SORT_CUTOFF) {
+        if (depthLimit == 0) {
+            make_heap(first, last, comp);
+            sort_heap(first, last, comp);
+            return;
+        }
+        depthLimit--;
+
+        // the median of three is the pivot, at *first; of the other two samples,
+        // one does not come after it and one does not come before it, so the
+        // scans below stop within the range without any bounds checks
+        move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+
+        // Hoare partitioning: values equal to the pivot stop both scans, so
+        // they end up split evenly between the two sides
+        RandomIt left = first + 1;
+        RandomIt right = last;
+        while (true) {
+            while (comp(*left, *first))
+                ++left;
+            --right;
+            while (comp(*first, *right))
+                --right;
+            if (!(left < right))
+                break;
+            iter_swap(left, right);
+            ++left;
+        }
+
+        // [first, left) does not come after the pivot, [left, last) does not come before it:
+        // recurse into the smaller side, and carry on with the larger one
+        if (left - first < last - left) {
+            quick_sort_loop(first, left, depthLimit, comp);
+            first = left;
+        } else {
+            quick_sort_loop(left, last, depthLimit, comp);
+            last = left;
+        }
+    }
+
+    insertion_sort(first, last, comp);
+}
+
+/*
+    Quicksort (introsort):
+    Time complexity O(n * log(n)); space complexity O(log(n))
+*/
+template <typename RandomIt, typename Compare = Ascending>
+void quick_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    size_t depthLimit = 0;
+    for (ptrdiff_t size = last - first; size > 1; size /= 2)
+        depthLimit += 2;
+
+    quick_sort_loop(first, last, depthLimit, comp);
+}
+
+template <typename RandomIt, typename Buffer, typename Compare>
+void merge_sort_loop(RandomIt first, RandomIt last, Buffer& buffer, Compare comp) {
+    if (last - first <= GENERIC_INSERTION_SORT_CUTOFF) {
+        insertion_sort(first, last, comp);
+        return;
+    }
+
+    const RandomIt mid = first + (last - first) / 2;
+    merge_sort_loop(first, mid, buffer, comp);
+    merge_sort_loop(mid, last, buffer, comp);
+
+    if (!comp(*mid, *(mid - 1)))    // the halves are in order already
+        return;
+
+    // move the first half out of the way (into the buffer's reserved memory),
+    // and merge it with the second half from the front; the first half wins ties
+    buffer.assign(make_move_iterator(first), make_move_iterator(mid));
+    auto next = buffer.begin();
+    RandomIt right = mid;
+    RandomIt output = first;
+
+    while (next != buffer.end() and right != last) {
+        if (comp(*right, *next))
+            *output++ = move(*right++);
+        else
+            *output++ = move(*next++);
+    }
+    move(next, buffer.end(), output);    // what is left of the second half is in place already
+}
+
+/*
+    Merge sort (stable):
+    Time complexity O(n * log(n)), O(n) on sorted input; space complexity O(n)
+*/
+template <typename RandomIt, typename Compare = Ascending>
+void merge_sort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    vector<typename iterator_traits<RandomIt>::value_type> buffer;
+    buffer.reserve((last - first) / 2);     // never reallocated after this
+
+    merge_sort_loop(first, last, buffer, comp);
+}
+
+// the position of key among all the keys counted from minimum, for any integral type
+template <typename Integer>
+unsigned long long key_offset(const Integer key, const Integer minimum) {
+    // in unsigned arithmetic, so that the difference itself cannot overflow (but for 64-bit
+    // keys spanning their whole range, the number of keys, this plus 1, wraps around to 0)
+    return (unsigned long long) key - (unsigned long long) minimum;
+}
+
+/*
+    Counting sort (stable):
+    Sorts by an integral key of each value, key(value), in ascending order,
+    or descending if asked. Keys of a range larger than
+    max(n, GENERIC_MIN_COUNTING_RANGE) are not worth counting (and 64-bit
+    ones may have more keys than a size_t can count), so they are merge
+    sorted by key instead.
+    Time complexity O(n + k), or O(n * log(n)) for larger ranges; space
+    complexity O(n + k), where k is the range of the keys
+*/
+template <typename RandomIt, typename Key>
+void counting_sort(RandomIt first, RandomIt last, Key key, const bool descending = false) {
+    typedef typename decay<decltype(key(*first))>::type KeyType;
+    static_assert(is_integral<KeyType>::value, "counting_sort needs integral keys");
+
+    if (last - first < 2)
+        return;
+
+    KeyType minimum = key(*first);
+    KeyType maximum = minimum;
+    for (RandomIt next = first; next != last; ++next) {
+        const KeyType value = key(*next);
+        if (value < minimum)
+            minimum = value;
+        if (value > maximum)
+            maximum = value;
+    }
+
+    const unsigned long long size = last - first;
+    if (key_offset(maximum, minimum) >= max(size, GENERIC_MIN_COUNTING_RANGE)) {
+        if (descending)
+            merge_sort(first, last, by_key(key, Descending()));
+        else
+            merge_sort(first, last, by_key(key, Ascending()));
+        return;
+    }
+
+    // starting position of each key in the output
+    vector<size_t> positions(key_offset(maximum, minimum) + 1, 0);
+    for (RandomIt next = first; next != last; ++next)
+        ++positions[key_offset(KeyType(key(*next)), minimum)];
+
+    size_t position = 0;
+    for (size_t i = 0; i < positions.size(); i++) {
+        size_t& start = positions[descending ? positions.size() - 1 - i : i];
+        const size_t count = start;
+        start = position;
+        position += count;
+    }
+
+    // place values in input order, to keep the sort stable
+    vector<typename iterator_traits<RandomIt>::value_type> values(make_move_iterator(first), make_move_iterator(last));
+    for (auto& value : values)
+        first[positions[key_offset(KeyType(key(value)), minimum)]++] = move(value);
+}
+
+// counting sort of integral values by themselves
+template <typename RandomIt>
+void counting_sort(RandomIt first, RandomIt last, const bool descending = false) {
+    typedef typename iterator_traits<RandomIt>::value_type Value;
+    counting_sort(first, last, [](const Value& value) { return value; }, descending);
+}
+
+#endif
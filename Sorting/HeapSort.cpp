@@ -0,0 +1,36 @@
+/*
+    Heapsort:
+    A comparison-based, in-place sorting algorithm that repeatedly moves the
+    largest (or smallest) value of a binary heap to the end of the array
+*/
+
+#include <iostream>
+#include <vector>
+
+#include "HeapSort.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+int main() {
+    size_t size;
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
+
+    vector<int> values(size);
+    getInputValues(values, size);
+
+    int order;
+    string orderText;
+    getOrder(order, orderText);
+
+    bool toShowState;
+    getWhetherToShowState(toShowState);
+
+    heapSort(values, order, toShowState);
+
+    cout << "\nThe values in " << orderText << " order are :\n";
+    displayState(values);
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+    Heapsort:
+    A comparison-based, in-place sorting algorithm that builds a binary heap
+    out of the values, and then repeatedly moves the top of the heap to the
+    end of the unsorted part. Its worst case is O(n * log(n)), which is why
+    introsort falls back on it when quicksort recurses too deep.
+
+    Time complexity:
+    O(n * log(n)), where n is the number of values to sort
+
+    Space complexity:
+    O(1)
+*/
+
+#ifndef HEAP_SORT_H
+#define HEAP_SORT_H
+
+#include <vector>
+
+#include "SortingUtils.h"
+
+using namespace std;
+
+// moves values[root] down the heap in values[start, start + heapSize) until both its children come before it
+void siftDown(vector<int>& values, const size_t start, const size_t heapSize, size_t root, const int order) {
+    const int rootValue = values[start + root];
+
+    while (2 * root + 1 < heapSize) {
+        size_t child = 2 * root + 1;
+        if (child + 1 < heapSize and comesBefore(values[start + child], values[start + child + 1], order))
+            child++;    // the child that comes later in order
+
+        if (!comesBefore(rootValue, values[start + child], order))
+            break;
+
+        values[start + root] = values[start + child];
+        SortingInstrumentation::moved(1);
+        root = child;
+    }
+    values[start + root] = rootValue;
+    SortingInstrumentation::moved(1);
+}
+
+// sorts values[start..end] (inclusive)
+void heapSort(vector<int>& values, const size_t start, const size_t end, const int order, const bool toShowState) {
+    const size_t size = end - start + 1;
+
+    // build a heap, with the value that comes last in order at the top
+    for (size_t root = size / 2; root-- > 0; )
+        siftDown(values, start, size, root, order);
+
+    for (size_t heapSize = size - 1; heapSize > 0; heapSize--) {
+        swap(values[start], values[start + heapSize]);
+        siftDown(values, start, heapSize, 0, order);
+
+        if (toShowState)
+            displayState(values);
+    }
+}
+
+void heapSort(vector<int>& values, const int order, const bool toShowState) {
+    if (!values.empty())
+        heapSort(values, 0, values.size() - 1, order, toShowState);
+}
+
+#endif
@@ -0,0 +1,44 @@
+/*
+    Indirect sorting:
+    Computes the permutation that sorts the given keys (argsort), and then
+    applies it, moving each value once, as it would move large records.
+*/
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "IndirectSort.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+int main() {
+    size_t size;
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
+
+    vector<int> values(size);
+    getInputValues(values, size);
+
+    int order;
+    string orderText;
+    getOrder(order, orderText);
+
+    size_t variant;
+    getVariant(variant, { "argsort by merge sort", "argsort by counting sort" });
+
+    const vector<uint32_t> permutation = variant == 1 ? argsortCounting(values, order) : argsortMerge(values, order);
+
+    cout << "\nThe indices of the values in " << orderText << " order are :\n";
+    for (const uint32_t& index : permutation)
+        cout << index << " ";
+    cout << "\n";
+
+    applyPermutation(values, permutation);
+
+    cout << "\nThe values in " << orderText << " order are :\n";
+    displayState(values);
+
+    return 0;
+}
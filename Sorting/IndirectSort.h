@@ -0,0 +1,212 @@
+/*
+    Indirect sorting:
+    Sorting large records by an int key without moving the records around.
+
+    keyPayloadMergeSort and keyPayloadCountingSort sort the keys together
+    with a 32-bit payload per key (usually the index of its record), kept in
+    a separate array (structure of arrays): every move of a key moves 4
+    bytes of payload along with it, instead of a whole record. The first is
+    a bottom-up merge sort like the one of MergeSort.h, the second a
+    counting sort like the one of CountingSort.h (for keys of a range up to
+    max(n, MIN_COUNTING_RANGE), falling back to the merge sort otherwise).
+    Both are stable. Their loops are their own, written over the two
+    arrays: the sorts of those headers move single ints, and those of
+    GenericSorting.h move whole values, which would put the keys and the
+    payloads back together in one array.
+
+    argsortMerge and argsortCounting compute the permutation that sorts the
+    keys: permutation[i] is the index of the i-th key in sorted order. They
+    sort the indices 0, 1, ..., n - 1 by their keys with the merge_sort and
+    counting_sort of GenericSorting.h (which falls back to merge_sort for
+    keys of too large a range). applyPermutation then moves each record
+    once, into its final place, following the cycles of the permutation.
+
+    Usage:
+        vector<int> keys(records.size());
+        for (size_t i = 0; i < records.size(); i++)
+            keys[i] = records[i].key;
+        applyPermutation(records, argsortMerge(keys, 1));
+
+    (At most 2^32 - 1 values, for the 32-bit payloads; the argsorts throw
+    length_error for more.)
+
+    Time complexity:
+    O(n * log(n)) for the merge sorts, O(n + k) for the counting sorts and
+    O(n) for applyPermutation, where n is the number of keys and k is their
+    range
+
+    Space complexity:
+    O(n) for the merge sorts, O(n + k) for the counting sorts, and O(n) bits
+    for applyPermutation
+*/
+
+#ifndef INDIRECT_SORT_H
+#define INDIRECT_SORT_H
+
+#include <algorithm>    // for min()
+#include <cstdint>
+#include <stdexcept>    // for length_error
+#include <utility>
+#include <vector>
+
+#include "CountingSort.h"
+#include "GenericSorting.h"
+#include "MergeSort.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+// insertion sorts keys[first, last), moving payloads[first, last) along
+void keyPayloadInsertionSort(vector<int>& keys, vector<uint32_t>& payloads, const size_t first,
+                             const size_t last, const int order) {
+    for (size_t i = first + 1; i < last; i++) {
+        const int key = keys[i];
+        const uint32_t payload = payloads[i];
+
+        size_t j = i;
+        for (; j > first and comesBefore(key, keys[j - 1], order); j--) {
+            keys[j] = keys[j - 1];
+            payloads[j] = payloads[j - 1];
+        }
+        keys[j] = key;
+        payloads[j] = payload;
+    }
+}
+
+/*
+    Merges the sorted runs [first, mid) and [mid, last) of sourceKeys (and
+    their payloads) into destinationKeys (and destinationPayloads), taking
+    from the first run when the keys are equal, as mergeInto does
+*/
+void keyPayloadMergeRuns(const vector<int>& sourceKeys, const vector<uint32_t>& sourcePayloads,
+                         vector<int>& destinationKeys, vector<uint32_t>& destinationPayloads,
+                         const size_t first, const size_t mid, const size_t last, const int order) {
+    size_t first1 = first, first2 = mid, next = first;
+
+    while (first1 < mid and first2 < last) {
+        const size_t from = comesBefore(sourceKeys[first2], sourceKeys[first1], order) ? first2++ : first1++;
+        destinationKeys[next] = sourceKeys[from];
+        destinationPayloads[next++] = sourcePayloads[from];
+    }
+
+    for (; first1 < mid; first1++, next++) {
+        destinationKeys[next] = sourceKeys[first1];
+        destinationPayloads[next] = sourcePayloads[first1];
+    }
+    for (; first2 < last; first2++, next++) {
+        destinationKeys[next] = sourceKeys[first2];
+        destinationPayloads[next] = sourcePayloads[first2];
+    }
+}
+
+void keyPayloadMergeSort(vector<int>& keys, vector<uint32_t>& payloads, const int order) {
+    const size_t size = keys.size();
+
+    for (size_t first = 0; first < size; first += MERGE_RUN_LENGTH)
+        keyPayloadInsertionSort(keys, payloads, first, min(first + MERGE_RUN_LENGTH, size), order);
+
+    if (size <= MERGE_RUN_LENGTH)
+        return;
+
+    // merge runs of doubling width back and forth between the arrays and the
+    // buffers, swapping them after each pass so that the sorted runs are always in keys
+    vector<int> keyBuffer(size);
+    vector<uint32_t> payloadBuffer(size);
+
+    for (size_t width = MERGE_RUN_LENGTH; width < size; width *= 2) {
+        for (size_t first = 0; first < size; first += 2 * width) {
+            const size_t mid = min(first + width, size);
+            const size_t last = min(first + 2 * width, size);
+            keyPayloadMergeRuns(keys, payloads, keyBuffer, payloadBuffer, first, mid, last, order);
+        }
+
+        keys.swap(keyBuffer);
+        payloads.swap(payloadBuffer);
+    }
+}
+
+void keyPayloadCountingSort(vector<int>& keys, vector<uint32_t>& payloads, const int order) {
+    if (keys.empty())
+        return;
+
+    const RangeScan scan = scanRange(keys);
+    const size_t unique_values = (long long) scan.maxValue - scan.minValue + 1;
+    if (unique_values > max(keys.size(), MIN_COUNTING_RANGE)) {
+        keyPayloadMergeSort(keys, payloads, order);
+        return;
+    }
+
+    vector<size_t> freq(unique_values, 0);
+    for (const int& key : keys)
+        ++freq[(long long) key - scan.minValue];
+
+    cumulate_frequencies(freq, order);
+
+    // place the keys and their payloads by iterating in reversed order, to keep the sort stable
+    vector<int> sortedKeys(keys.size());
+    vector<uint32_t> sortedPayloads(payloads.size());
+    for (size_t i = keys.size(); i-- > 0;) {
+        const size_t position = --freq[(long long) keys[i] - scan.minValue];
+        sortedKeys[position] = keys[i];
+        sortedPayloads[position] = payloads[i];
+    }
+
+    keys.swap(sortedKeys);
+    payloads.swap(sortedPayloads);
+}
+
+// 0, 1, ..., size - 1 (throws length_error for more than 2^32 - 1 values)
+vector<uint32_t> identityPermutation(const size_t size) {
+    if (size > UINT32_MAX)
+        throw length_error("indirect sorting is limited to 2^32 - 1 keys");
+
+    vector<uint32_t> permutation(size);
+    for (size_t i = 0; i < size; i++)
+        permutation[i] = i;
+    return permutation;
+}
+
+// the indices of the keys in (stable) sorted order
+vector<uint32_t> argsortMerge(const vector<int>& keys, const int order) {
+    vector<uint32_t> permutation = identityPermutation(keys.size());
+    const auto keyOf = [&keys](const uint32_t i) { return keys[i]; };
+    if (order == -1)
+        merge_sort(permutation.begin(), permutation.end(), by_key(keyOf, Descending()));
+    else
+        merge_sort(permutation.begin(), permutation.end(), by_key(keyOf, Ascending()));
+    return permutation;
+}
+
+vector<uint32_t> argsortCounting(const vector<int>& keys, const int order) {
+    vector<uint32_t> permutation = identityPermutation(keys.size());
+    counting_sort(permutation.begin(), permutation.end(), [&keys](const uint32_t i) { return keys[i]; }, order == -1);
+    return permutation;
+}
+
+/*
+    Rearranges records so that records[i] becomes what was records[permutation[i]].
+    Each cycle of the permutation is followed from one of its records, which
+    is set aside: every other record of the cycle is moved straight into its
+    place, so it is moved once only.
+*/
+template <typename Record>
+void applyPermutation(vector<Record>& records, const vector<uint32_t>& permutation) {
+    vector<bool> isPlaced(records.size(), false);
+
+    for (size_t start = 0; start < records.size(); start++) {
+        if (isPlaced[start] or permutation[start] == start)
+            continue;
+
+        Record startRecord = move(records[start]);
+        size_t current = start;
+        while (permutation[current] != start) {
+            records[current] = move(records[permutation[current]]);
+            isPlaced[current] = true;
+            current = permutation[current];
+        }
+        records[current] = move(startRecord);
+        isPlaced[current] = true;
+    }
+}
+
+#endif
@@ -7,33 +7,15 @@
 #include <iostream>
 #include <vector>
 
+#include "InsertionSort.h"
 #include "SortingUtils.h"
 
 using namespace std;
 
-void insertionSort(vector<int>& values, const int order, const bool toShowState) {
-    size_t i, j;
-    int currentValue;
-
-    for (i = 1; i < values.size(); i++) {
-        j = i;
-        currentValue = values[j];
-
-        // 'order' is -1 for descending, so the inequality is reversed:
-        while (j > 0 && (order * values[j-1] > order * currentValue)) {
-            values[j] = values[j-1];
-            j--;
-        }
-        values[j] = currentValue;
-
-        if (toShowState)
-            displayState(values);
-    }
-}
-
 int main() {
     size_t size;
-    getInputSize(size);
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
 
     vector<int> values(size);
     getInputValues(values, size);
@@ -0,0 +1,50 @@
+/*
+    Insertion sort:
+    A simple sorting algorithm that builds the final sorted array (or list)
+    one item at a time. Being fast on small and nearly sorted ranges, it is
+    also used by the other sorts to finish off small ranges.
+
+    Time complexity:
+    O(n^2), where n is the number of values to sort (O(n) if they are already
+    sorted)
+
+    Space complexity:
+    O(1)
+*/
+
+#ifndef INSERTION_SORT_H
+#define INSERTION_SORT_H
+
+#include <vector>
+
+#include "SortingUtils.h"
+
+using namespace std;
+
+// sorts values[start..end] (inclusive)
+void insertionSort(vector<int>& values, const size_t start, const size_t end, const int order, const bool toShowState) {
+    size_t i, j;
+    int currentValue;
+
+    for (i = start + 1; i <= end; i++) {
+        j = i;
+        currentValue = values[j];
+
+        while (j > start && comesBefore(currentValue, values[j-1], order)) {
+            values[j] = values[j-1];
+            j--;
+        }
+        values[j] = currentValue;
+        SortingInstrumentation::moved(i - j + 1);   // the shifted values, and the current one
+
+        if (toShowState)
+            displayState(values);
+    }
+}
+
+void insertionSort(vector<int>& values, const int order, const bool toShowState) {
+    if (!values.empty())
+        insertionSort(values, 0, values.size() - 1, order, toShowState);
+}
+
+#endif
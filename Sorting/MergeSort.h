@@ -0,0 +1,173 @@
+/*
+    Merge sort:
+    An efficient, comparison-based, divide and conquer sorting algorithm
+
+    mergeSort is the classic recursive version, which allocates a temporary
+    vector for every merge, and copies it back.
+
+    pingPongMergeSort allocates a single buffer (a copy of the values) once,
+    and swaps the roles of the values and the buffer at each level of the
+    recursion: both halves are sorted into one of them, and merged into the
+    other, so nothing is ever copied back. Small ranges are insertion sorted.
+
+    bottomUpMergeSort is not recursive: it insertion sorts runs of
+    MERGE_RUN_LENGTH values, and then merges pairs of runs of doubling width,
+    back and forth between the values and a single buffer.
+
+    Both of them are stable, and make O(1) allocations instead of O(n).
+
+    Time complexity:
+    O(n * log(n)), where n is the number of values to sort
+
+    Space complexity:
+    O(n), where n is the number of values to sort
+*/
+
+#ifndef MERGE_SORT_H
+#define MERGE_SORT_H
+
+#include <algorithm>    // for min()
+#include <vector>
+
+#include "InsertionSort.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+const size_t MERGE_RUN_LENGTH = 32;     // ranges this small are insertion sorted
+
+void merge(vector<int>& values, const size_t start, const size_t end, const int order) {
+    size_t mid = (start + end) / 2;
+    size_t index1 = start;
+    size_t index2 = mid + 1;
+
+    vector<int> tempVect(end - start + 1);
+    SortingInstrumentation::allocated(tempVect.size() * sizeof(int));
+    SortingInstrumentation::moved(2 * tempVect.size());     // into tempVect, and back
+
+    for (int& nextVal: tempVect) {
+        if (index1 > mid)       // first part has ended, copy from the second part
+            nextVal = values[index2++];
+        else if (index2 > end)  // second part has ended, copy from the first part
+            nextVal = values[index1++];
+        else {          // copy the value that's next in order
+            // the first part wins ties, to keep the sort stable
+            if (comesBefore(values[index2], values[index1], order))
+                nextVal = values[index2++];
+            else
+                nextVal = values[index1++];
+        }
+    }
+
+    size_t s = start;
+    for (const int& sortedVal: tempVect)
+       values[s++] = sortedVal;
+}
+
+void mergeSort(vector<int>& values, const size_t start, const size_t end, const int order, const bool toShowState) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    if (start < end) {
+        size_t mid = (start + end) / 2;
+
+        mergeSort(values, start, mid, order, toShowState);
+        mergeSort(values, mid+1, end, order, toShowState);
+
+        merge(values, start, end, order);
+
+        if (toShowState)
+            displayState(values);
+    }
+}
+
+/*
+    Merges the sorted runs source[first1, last1) and source[first2, last2) into
+    destination, starting at index next, taking from the first run when the
+    values are equal, so that the merge is stable
+*/
+void mergeInto(const vector<int>& source, size_t first1, const size_t last1, size_t first2, const size_t last2,
+               vector<int>& destination, size_t next, const int order) {
+    SortingInstrumentation::moved((last1 - first1) + (last2 - first2));
+
+    while (first1 < last1 and first2 < last2) {
+        if (!comesBefore(source[first2], source[first1], order))
+            destination[next++] = source[first1++];
+        else
+            destination[next++] = source[first2++];
+    }
+
+    while (first1 < last1)
+        destination[next++] = source[first1++];
+    while (first2 < last2)
+        destination[next++] = source[first2++];
+}
+
+// merges the sorted runs source[first, mid) and source[mid, last) into destination[first, last)
+void mergeRuns(const vector<int>& source, vector<int>& destination, const size_t first, const size_t mid,
+               const size_t last, const int order) {
+    mergeInto(source, first, mid, mid, last, destination, first, order);
+}
+
+/*
+    Sorts destination[first, last), where source[first, last) holds the same
+    values to begin with: the halves get sorted into source (with the roles
+    swapped), and are then merged back into destination.
+*/
+void pingPongMergeSort(vector<int>& source, vector<int>& destination, const size_t first, const size_t last,
+                       const int order, const bool toShowState) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    if (last - first <= MERGE_RUN_LENGTH) {
+        if (last - first > 1)
+            insertionSort(destination, first, last - 1, order, false);
+        return;
+    }
+
+    const size_t mid = first + (last - first) / 2;
+    pingPongMergeSort(destination, source, first, mid, order, toShowState);
+    pingPongMergeSort(destination, source, mid, last, order, toShowState);
+
+    mergeRuns(source, destination, first, mid, last, order);
+
+    if (toShowState)
+        displayState(destination);
+}
+
+void pingPongMergeSort(vector<int>& values, const int order, const bool toShowState) {
+    vector<int> buffer(values);     // the only allocation
+    SortingInstrumentation::allocated(buffer.size() * sizeof(int));
+    pingPongMergeSort(buffer, values, 0, values.size(), order, toShowState);
+}
+
+void bottomUpMergeSort(vector<int>& values, const int order, const bool toShowState) {
+    const size_t size = values.size();
+
+    for (size_t first = 0; first < size; first += MERGE_RUN_LENGTH)
+        insertionSort(values, first, min(first + MERGE_RUN_LENGTH, size) - 1, order, false);
+
+    if (size <= MERGE_RUN_LENGTH)
+        return;
+
+    vector<int> buffer(size);   // the only allocation
+    SortingInstrumentation::allocated(buffer.size() * sizeof(int));
+    vector<int>* source = &values;
+    vector<int>* destination = &buffer;
+
+    for (size_t width = MERGE_RUN_LENGTH; width < size; width *= 2) {
+        for (size_t first = 0; first < size; first += 2 * width) {
+            const size_t mid = min(first + width, size);
+            const size_t last = min(first + 2 * width, size);
+            mergeRuns(*source, *destination, first, mid, last, order);
+        }
+
+        swap(source, destination);
+
+        if (toShowState)
+            displayState(*source);
+    }
+
+    if (source != &values)  // after an odd number of passes, the result is in the buffer
+        values.swap(buffer);
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+    Parallel counting sort (stable):
+    Counting sort with the values cut into one slice per thread. Each thread
+    counts the values of its own slice into a private histogram. The
+    histograms are then combined with a parallel prefix sum into, for every
+    thread and every key, the position where the first value of that key in
+    the thread's slice goes. Finally each thread scatters its own slice to
+    those positions, in input order, so the sort stays stable. No two threads
+    ever write to the same counter, so there are no atomics or locks.
+
+    The keys are ranked in the sorting order (value - min for ascending,
+    max - value for descending), so the prefix sum always runs in one
+    direction. The range scan also tells whether the values are sorted
+    already, in which case nothing else is done. A range much larger than
+    the number of values would make the histograms dominate, so it falls
+    back to radix_sort then, and small inputs go to the sequential
+    counting_sort.
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O((n + T * k) / T + T), where n is the number of values to sort, k is the
+    range of the values and T is the number of threads
+
+    Space complexity:
+    O(n + T * k)
+*/
+
+#ifndef PARALLEL_COUNTING_SORT_H
+#define PARALLEL_COUNTING_SORT_H
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "CountingSort.h"
+#include "RangeScan.h"
+#include "../Utils/WorkStealingPool.h"
+
+using namespace std;
+
+const size_t PARALLEL_COUNTING_GRAIN_SIZE = 1 << 16;  // fewer values per thread than this are sorted sequentially
+
+// runs work(0), ..., work(thread_count - 1) on thread_count threads (one of them the calling thread)
+void run_on_threads(const unsigned int thread_count, const function<void(unsigned int)> &work) {
+    vector<thread> workers;
+    for (unsigned int t = 1; t < thread_count; t++)
+        workers.emplace_back(work, t);
+    work(0);
+
+    for (thread &worker : workers)
+        worker.join();
+}
+
+void parallel_counting_sort(vector<int> &values, const int order,
+                            unsigned int thread_count = hardwareThreadCount()) {
+    const size_t size = values.size();
+    if (size == 0)
+        return;
+    thread_count = max(1u, (unsigned int) min<size_t>(thread_count, size / PARALLEL_COUNTING_GRAIN_SIZE));
+
+    // slice t of the values is [slice_start(t), slice_start(t + 1))
+    auto slice_start = [&](const size_t t) { return size * t / thread_count; };
+
+    // find minimum and maximum values, and whether they are sorted, per slice first
+    vector<RangeScan> scans(thread_count);
+    run_on_threads(thread_count, [&](const unsigned int t) {
+        scans[t] = scanRange(values.data() + slice_start(t), slice_start(t + 1) - slice_start(t));
+    });
+
+    RangeScan scan = scans[0];
+    for (unsigned int t = 1; t < thread_count; t++) {
+        const int last_value = values[slice_start(t) - 1];
+        const int first_value = values[slice_start(t)];
+
+        scan.minValue = min(scan.minValue, scans[t].minValue);
+        scan.maxValue = max(scan.maxValue, scans[t].maxValue);
+        scan.isAscending = scan.isAscending and scans[t].isAscending and last_value <= first_value;
+        scan.isDescending = scan.isDescending and scans[t].isDescending and last_value >= first_value;
+    }
+    if (sortIfMonotonic(values, scan, order))
+        return;
+
+    const int min_value = scan.minValue;
+    const int max_value = scan.maxValue;
+
+    const size_t unique_values = (long long) max_value - min_value + 1;
+    if (unique_values > max(size, MIN_COUNTING_RANGE)) {
+        radix_sort(values, order, false);
+        return;
+    }
+    if (thread_count == 1) {
+        counting_sort(values, order, false);
+        return;
+    }
+
+    // rank of a value: its key's position in the sorting order
+    auto rank = [&](const int value) -> size_t {
+        return order == 1 ? (long long) value - min_value : (long long) max_value - value;
+    };
+
+    // private histogram of each slice; freq[t][r] is the number of values of rank r in slice t
+    vector<vector<size_t>> freq(thread_count);
+    SortingInstrumentation::allocated(thread_count * unique_values * sizeof(size_t));
+    run_on_threads(thread_count, [&](const unsigned int t) {
+        freq[t].assign(unique_values, 0);
+        for (size_t i = slice_start(t); i < slice_start(t + 1); i++)
+            ++freq[t][rank(values[i])];
+    });
+
+    // prefix sum over (rank, slice), in that order: each thread first totals a
+    // chunk of the ranks, then the chunk totals are scanned, then each thread
+    // turns its chunk into starting positions, freq[t][r] being where the first
+    // value of rank r in slice t goes
+    auto chunk_start = [&](const size_t t) { return unique_values * t / thread_count; };
+
+    vector<size_t> chunk_total(thread_count + 1, 0);
+    run_on_threads(thread_count, [&](const unsigned int t) {
+        size_t total = 0;
+        for (size_t r = chunk_start(t); r < chunk_start(t + 1); r++)
+            for (unsigned int slice = 0; slice < thread_count; slice++)
+                total += freq[slice][r];
+        chunk_total[t + 1] = total;
+    });
+    for (unsigned int t = 0; t < thread_count; t++)
+        chunk_total[t + 1] += chunk_total[t];
+
+    run_on_threads(thread_count, [&](const unsigned int t) {
+        size_t position = chunk_total[t];
+        for (size_t r = chunk_start(t); r < chunk_start(t + 1); r++) {
+            for (unsigned int slice = 0; slice < thread_count; slice++) {
+                const size_t count = freq[slice][r];
+                freq[slice][r] = position;
+                position += count;
+            }
+        }
+    });
+
+    // each thread places its slice, in input order, to keep the sort stable
+    vector<int> sorted(size);
+    SortingInstrumentation::allocated(size * sizeof(int));
+    SortingInstrumentation::moved(size);
+    run_on_threads(thread_count, [&](const unsigned int t) {
+        vector<size_t> &position = freq[t];
+        for (size_t i = slice_start(t); i < slice_start(t + 1); i++)
+            sorted[position[rank(values[i])]++] = values[i];
+    });
+
+    values.swap(sorted);
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+    Parallel merge sort:
+    The ping-pong merge sort on a work-stealing pool of threads. Both halves
+    are sorted in parallel, and each merge is split too, using merge paths:
+    the output of a merge is cut into pieces, and for the start of each piece
+    a binary search (the co-rank) finds how many of its values come from each
+    run, so that all the pieces can be merged independently. This way even
+    the top-level merges, which are a single O(n) pass in mergeSort, use all
+    the threads. Ranges smaller than the grain size are sorted or merged
+    sequentially. It is stable, like the sequential merge sorts.
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O(n * log(n) / T + log^3(n)), where n is the number of values to sort and
+    T is the number of threads
+
+    Space complexity:
+    O(n), where n is the number of values to sort
+*/
+
+#ifndef PARALLEL_MERGE_SORT_H
+#define PARALLEL_MERGE_SORT_H
+
+#include <algorithm>
+#include <vector>
+
+#include "MergeSort.h"
+#include "../Utils/WorkStealingPool.h"
+
+using namespace std;
+
+const size_t PARALLEL_MERGE_GRAIN_SIZE = 1 << 14;   // ranges smaller than this are sorted or merged sequentially
+
+/*
+    Co-rank of a position in the merge of source[first1, last1) and
+    source[first2, last2): how many of the first 'position' merged values come
+    from the first run (the rest come from the second one). Ties go to the
+    first run, as in mergeInto.
+*/
+size_t mergeCoRank(const vector<int>& source, const size_t first1, const size_t last1,
+                   const size_t first2, const size_t last2, const size_t position, const int order) {
+    const size_t length1 = last1 - first1;
+    const size_t length2 = last2 - first2;
+
+    size_t low = position > length2 ? position - length2 : 0;
+    size_t high = min(position, length1);
+
+    // find the smallest count1, such that source[first1 + count1] does not belong to the first 'position' values
+    while (low < high) {
+        const size_t count1 = low + (high - low) / 2;
+        const size_t count2 = position - count1;
+
+        if (count2 > 0 and !comesBefore(source[first2 + count2 - 1], source[first1 + count1], order))
+            low = count1 + 1;   // source[first1 + count1] comes no later than a value already taken from the second run
+        else
+            high = count1;
+    }
+
+    return low;
+}
+
+// merges source[first, mid) and source[mid, last) into destination[first, last), in parallel pieces
+void parallelMerge(WorkStealingPool& pool, const vector<int>& source, vector<int>& destination,
+                   const size_t first, const size_t mid, const size_t last,
+                   const size_t pieceFirst, const size_t pieceLast, const int order, const size_t grainSize) {
+    if (pieceLast - pieceFirst <= grainSize) {
+        // the piece of the output from pieceFirst to pieceLast (relative to first)
+        const size_t start1 = mergeCoRank(source, first, mid, mid, last, pieceFirst, order);
+        const size_t end1 = mergeCoRank(source, first, mid, mid, last, pieceLast, order);
+
+        mergeInto(source, first + start1, first + end1,
+                  mid + (pieceFirst - start1), mid + (pieceLast - end1),
+                  destination, first + pieceFirst, order);
+        return;
+    }
+
+    const size_t pieceMid = pieceFirst + (pieceLast - pieceFirst) / 2;
+    pool.parallel_invoke(
+        [&]() { parallelMerge(pool, source, destination, first, mid, last, pieceFirst, pieceMid, order, grainSize); },
+        [&]() { parallelMerge(pool, source, destination, first, mid, last, pieceMid, pieceLast, order, grainSize); });
+}
+
+// sorts destination[first, last), where source[first, last) holds the same values (see pingPongMergeSort)
+void parallelMergeSortTask(WorkStealingPool& pool, vector<int>& source, vector<int>& destination,
+                           const size_t first, const size_t last, const int order, const size_t grainSize) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    if (last - first <= grainSize) {
+        pingPongMergeSort(source, destination, first, last, order, false);
+        return;
+    }
+
+    const size_t mid = first + (last - first) / 2;
+    pool.parallel_invoke(
+        [&]() { parallelMergeSortTask(pool, destination, source, first, mid, order, grainSize); },
+        [&]() { parallelMergeSortTask(pool, destination, source, mid, last, order, grainSize); });
+
+    parallelMerge(pool, source, destination, first, mid, last, 0, last - first, order, grainSize);
+}
+
+void parallelMergeSort(vector<int>& values, const int order, const unsigned int threadCount = hardwareThreadCount(),
+                       const size_t grainSize = PARALLEL_MERGE_GRAIN_SIZE) {
+    vector<int> buffer(values);
+    SortingInstrumentation::allocated(buffer.size() * sizeof(int));
+    WorkStealingPool pool(threadCount);
+    pool.run([&]() {
+        parallelMergeSortTask(pool, buffer, values, 0, values.size(), order, max<size_t>(grainSize, 1));
+    });
+}
+
+#endif
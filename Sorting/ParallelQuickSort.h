@@ -0,0 +1,87 @@
+/*
+    Parallel quicksort:
+    Quicksort on a work-stealing pool of threads. Each partition step (block
+    partitioning, as in blockQuickSort) spawns the smaller side as a new task,
+    which idle threads steal, and carries on with the larger side itself.
+    Ranges smaller than the grain size are sorted sequentially with
+    blockQuickSort, so that tasks are not spawned for too little work. The
+    result is the same as that of the sequential quickSort.
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O(n * log(n) / T + n), where n is the number of values to sort and T is
+    the number of threads (the first partition steps are sequential)
+
+    Space complexity:
+    O(T * log(n)), where n is the number of values to sort and T is the
+    number of threads
+*/
+
+#ifndef PARALLEL_QUICK_SORT_H
+#define PARALLEL_QUICK_SORT_H
+
+#include <vector>
+
+#include "QuickSort.h"
+#include "../Utils/WorkStealingPool.h"
+
+using namespace std;
+
+const size_t PARALLEL_GRAIN_SIZE = 1 << 14;     // ranges smaller than this are sorted sequentially
+
+// sorts values[first, last), spawning the smaller side of each partition as a task
+void parallelQuickSortTask(WorkStealingPool& pool, vector<int>& values, size_t first, size_t last,
+                           size_t depthLimit, const int order, const size_t grainSize) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    while (last - first >= grainSize) {
+        if (depthLimit == 0) {
+            heapSort(values, first, last - 1, order, false);
+            return;
+        }
+        depthLimit--;
+
+        swap(values[first], values[choosePivot(values, first, last, order)]);
+
+        // the pivot is the minimum, and has duplicates (see blockQuickSortLoop)
+        if (first > 0 and !comesBefore(values[first - 1], values[first], order)) {
+            size_t equalFirst, equalLast;
+            threeWayPartition(values, first, last, values[first], order, equalFirst, equalLast);
+            first = equalLast;
+            continue;
+        }
+
+        const size_t pivotIndex = blockPartition(values, first, last, order);
+
+        // spawn the smaller side, and carry on with the larger one
+        size_t smallerFirst = first, smallerLast = pivotIndex;
+        if (pivotIndex - first < last - pivotIndex - 1) {
+            first = pivotIndex + 1;
+        } else {
+            smallerFirst = pivotIndex + 1;
+            smallerLast = last;
+            last = pivotIndex;
+        }
+
+        pool.spawn([&pool, &values, smallerFirst, smallerLast, depthLimit, order, grainSize]() {
+            parallelQuickSortTask(pool, values, smallerFirst, smallerLast, depthLimit, order, grainSize);
+        });
+    }
+
+    blockQuickSortLoop(values, first, last, depthLimit, order, false);
+}
+
+void parallelQuickSort(vector<int>& values, const int order, const unsigned int threadCount = hardwareThreadCount(),
+                       const size_t grainSize = PARALLEL_GRAIN_SIZE) {
+    if (values.empty() or sortIfMonotonic(values, scanRange(values), order))
+        return;
+
+    WorkStealingPool pool(threadCount);
+    pool.run([&]() {
+        parallelQuickSortTask(pool, values, 0, values.size(), introSortDepthLimit(values.size()), order,
+                              grainSize > 0 ? grainSize : 1);
+    });
+}
+
+#endif
@@ -0,0 +1,314 @@
+/*
+    Quicksort:
+    An efficient, comparison-based, in-place, divide and conquer sorting algorithm
+
+    quickSort is the classic version, with a random pivot and Lomuto partitioning.
+
+    introSort is the production version:
+    - the pivot is the median of 3 values, or for large ranges the ninther
+      (the median of the medians of 3 groups of 3 values), without any rand()
+    - partitioning is 3-way (Dutch national flag), so that all the values equal
+      to the pivot are placed in one go, and many duplicates do not make it
+      quadratic
+    - ranges of at most INSERTION_SORT_CUTOFF values are left to insertion sort
+    - once the recursion is more than 2 * log(n) levels deep, the range is
+      heapsorted, which guarantees O(n * log(n)) time
+    - it only recurses into the smaller side of each partition, which bounds
+      the stack depth to O(log(n))
+
+    blockQuickSort is introSort with branchless block partitioning (as in
+    BlockQuicksort): the comparisons with the pivot for a block of
+    PARTITION_BLOCK_SIZE values from each end are recorded in offset buffers
+    without branching, and then the misplaced values are swapped in bulk, so
+    the loop does not mispredict on random data. Ranges whose pivot equals the
+    value just before them (which then is their minimum) are split 3-way
+    instead, so that duplicates are handled in one go.
+
+    Time complexity:
+    quickSort: O(n * log(n)) on average, O(n^2) in the worst case
+    introSort, blockQuickSort: O(n * log(n)), where n is the number of values to sort
+
+    Space complexity:
+    quickSort: O(log(n)) on average, O(n) in the worst case
+    introSort, blockQuickSort: O(log(n)), where n is the number of values to sort
+*/
+
+#ifndef QUICK_SORT_H
+#define QUICK_SORT_H
+
+#include <algorithm>    // for min()
+#include <cstdlib>      // for rand()
+#include <vector>
+
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "RangeScan.h"
+#include "SortingUtils.h"
+
+using namespace std;
+
+const size_t INSERTION_SORT_CUTOFF = 24;    // ranges this small are insertion sorted
+const size_t NINTHER_THRESHOLD = 128;       // ranges this large take the ninther as pivot
+const size_t PARTITION_BLOCK_SIZE = 64;     // values compared at a time from each end by blockPartition
+
+size_t partition(vector<int>& values, const size_t start, const size_t end, const int order) {
+    // choose a random index between start & end
+    size_t randomIndex = start + (rand() % (end - start + 1));
+
+    // swap the value there with the first value in given range
+    swap(values[randomIndex], values[start]);
+
+    // make that value the pivot element
+    int pivot = values[start];
+
+    size_t i = start + 1;
+    for (size_t j = start + 1; j <= end; j++)  {
+        /*
+            place elements which are less than the pivot on one side,
+            and those which are greater on the other
+        */
+        if (comesBefore(values[j], pivot, order)) {
+            swap(values[i], values[j]);
+            i++;
+        }
+    }
+
+    // place the pivot in its proper place
+    swap(values[start], values[i-1]);
+
+    return i-1;     // pivot's index
+}
+
+void quickSort(vector<int>& values, const int start, const int end, const int order, const bool toShowState) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    if (start < end) {
+        size_t pivotIndex = partition(values, start, end, order);
+
+        // sort values to the left of pivot
+        quickSort(values, start, pivotIndex-1, order, toShowState);
+
+        // sort values to the right of pivot
+        quickSort(values, pivotIndex+1, end, order, toShowState);
+
+        if (toShowState)
+            displayState(values);
+    }
+}
+
+// index of the median of values[a], values[b] and values[c]
+size_t medianOfThree(const vector<int>& values, const size_t a, const size_t b, const size_t c, const int order) {
+    if (comesBefore(values[a], values[b], order)) {
+        if (comesBefore(values[b], values[c], order))
+            return b;
+        return comesBefore(values[a], values[c], order) ? c : a;
+    }
+    if (comesBefore(values[a], values[c], order))
+        return a;
+    return comesBefore(values[b], values[c], order) ? c : b;
+}
+
+// index of a pivot for values[first, last): the median of 3, or the ninther for large ranges
+size_t choosePivot(const vector<int>& values, const size_t first, const size_t last, const int order) {
+    const size_t size = last - first;
+    const size_t mid = first + size / 2;
+
+    if (size < NINTHER_THRESHOLD)
+        return medianOfThree(values, first, mid, last - 1, order);
+
+    const size_t step = size / 8;
+    return medianOfThree(values,
+        medianOfThree(values, first, first + step, first + 2 * step, order),
+        medianOfThree(values, mid - step, mid, mid + step, order),
+        medianOfThree(values, last - 1 - 2 * step, last - 1 - step, last - 1, order),
+        order);
+}
+
+/*
+    3-way (Dutch national flag) partitioning of values[first, last) around the
+    pivot value, after which
+        values[first, equalFirst) come before the pivot,
+        values[equalFirst, equalLast) are equal to the pivot, and
+        values[equalLast, last) come after the pivot
+*/
+void threeWayPartition(vector<int>& values, const size_t first, const size_t last, const int pivot, const int order,
+                       size_t& equalFirst, size_t& equalLast) {
+    size_t lessEnd = first;     // end of the values that come before the pivot
+    size_t i = first;           // values[lessEnd, i) are equal to the pivot
+    size_t greaterStart = last; // start of the values that come after the pivot
+
+    while (i < greaterStart) {
+        if (comesBefore(values[i], pivot, order))
+            swap(values[lessEnd++], values[i++]);
+        else if (comesBefore(pivot, values[i], order))
+            swap(values[i], values[--greaterStart]);
+        else
+            i++;
+    }
+
+    equalFirst = lessEnd;
+    equalLast = greaterStart;
+}
+
+// sorts values[first, last), heapsorting once depthLimit more levels of partitioning have been used
+void introSortLoop(vector<int>& values, size_t first, size_t last, size_t depthLimit, const int order, const bool toShowState) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    while (last - first > INSERTION_SORT_CUTOFF) {
+        if (depthLimit == 0) {
+            heapSort(values, first, last - 1, order, toShowState);
+            return;
+        }
+        depthLimit--;
+
+        const int pivot = values[choosePivot(values, first, last, order)];
+        size_t equalFirst, equalLast;
+        threeWayPartition(values, first, last, pivot, order, equalFirst, equalLast);
+
+        if (toShowState)
+            displayState(values);
+
+        // recurse into the smaller side, and loop on the larger one
+        if (equalFirst - first < last - equalLast) {
+            introSortLoop(values, first, equalFirst, depthLimit, order, toShowState);
+            first = equalLast;
+        } else {
+            introSortLoop(values, equalLast, last, depthLimit, order, toShowState);
+            last = equalFirst;
+        }
+    }
+
+    if (last - first > 1)
+        insertionSort(values, first, last - 1, order, toShowState);
+}
+
+size_t introSortDepthLimit(const size_t size) {
+    size_t log2Size = 0;
+    for (size_t remaining = size; remaining > 1; remaining /= 2)
+        log2Size++;
+
+    return 2 * log2Size;
+}
+
+void introSort(vector<int>& values, const int order, const bool toShowState) {
+    if (values.empty() or sortIfMonotonic(values, scanRange(values), order))
+        return;
+
+    introSortLoop(values, 0, values.size(), introSortDepthLimit(values.size()), order, toShowState);
+}
+
+/*
+    Partitions values[first, last) around values[first], the pivot, and returns
+    the pivot's final index, with the values that come before the pivot to its
+    left, and the rest to its right.
+*/
+size_t blockPartition(vector<int>& values, const size_t first, const size_t last, const int order) {
+    const int pivot = values[first];
+    size_t left = first + 1;    // values[first + 1, left) come before the pivot
+    size_t right = last;        // values[right, last) do not
+
+    unsigned char leftOffsets[PARTITION_BLOCK_SIZE], rightOffsets[PARTITION_BLOCK_SIZE];
+    size_t leftCount = 0, rightCount = 0;   // offsets of misplaced values, yet to be swapped
+    size_t leftStart = 0, rightStart = 0;
+
+    while (right - left > 2 * PARTITION_BLOCK_SIZE) {
+        // record which values of each block are on the wrong side, without branching
+        if (leftCount == 0) {
+            leftStart = 0;
+            for (size_t i = 0; i < PARTITION_BLOCK_SIZE; i++) {
+                leftOffsets[leftCount] = i;
+                leftCount += !comesBefore(values[left + i], pivot, order);
+            }
+        }
+        if (rightCount == 0) {
+            rightStart = 0;
+            for (size_t i = 0; i < PARTITION_BLOCK_SIZE; i++) {
+                rightOffsets[rightCount] = i;
+                rightCount += comesBefore(values[right - 1 - i], pivot, order);
+            }
+        }
+
+        // swap the misplaced values in pairs
+        const size_t swapCount = min(leftCount, rightCount);
+        for (size_t i = 0; i < swapCount; i++)
+            swap(values[left + leftOffsets[leftStart + i]], values[right - 1 - rightOffsets[rightStart + i]]);
+
+        leftCount -= swapCount;
+        rightCount -= swapCount;
+        leftStart += swapCount;
+        rightStart += swapCount;
+
+        // a block is done once it has no misplaced values left
+        if (leftCount == 0)
+            left += PARTITION_BLOCK_SIZE;
+        if (rightCount == 0)
+            right -= PARTITION_BLOCK_SIZE;
+    }
+
+    // everything outside [left, right) is in place, so partition what is left (at most 3 blocks) one value at a time
+    while (true) {
+        while (left < right and comesBefore(values[left], pivot, order))
+            left++;
+        while (left < right and !comesBefore(values[right - 1], pivot, order))
+            right--;
+        if (left >= right)
+            break;
+        swap(values[left++], values[--right]);
+    }
+
+    // place the pivot in its proper place
+    swap(values[first], values[left - 1]);
+
+    return left - 1;
+}
+
+// like introSortLoop, but with block partitioning
+void blockQuickSortLoop(vector<int>& values, size_t first, size_t last, size_t depthLimit, const int order, const bool toShowState) {
+    SortingInstrumentation::RecursionLevel recursionLevel;
+
+    while (last - first > INSERTION_SORT_CUTOFF) {
+        if (depthLimit == 0) {
+            heapSort(values, first, last - 1, order, toShowState);
+            return;
+        }
+        depthLimit--;
+
+        swap(values[first], values[choosePivot(values, first, last, order)]);
+
+        // the value just before the range is never after any value in it, so if the
+        // pivot is not after it either, the pivot is the minimum and has duplicates:
+        // put them all in place and carry on with the rest
+        if (first > 0 and !comesBefore(values[first - 1], values[first], order)) {
+            size_t equalFirst, equalLast;
+            threeWayPartition(values, first, last, values[first], order, equalFirst, equalLast);
+            first = equalLast;
+            continue;
+        }
+
+        const size_t pivotIndex = blockPartition(values, first, last, order);
+
+        if (toShowState)
+            displayState(values);
+
+        // recurse into the smaller side, and loop on the larger one
+        if (pivotIndex - first < last - pivotIndex - 1) {
+            blockQuickSortLoop(values, first, pivotIndex, depthLimit, order, toShowState);
+            first = pivotIndex + 1;
+        } else {
+            blockQuickSortLoop(values, pivotIndex + 1, last, depthLimit, order, toShowState);
+            last = pivotIndex;
+        }
+    }
+
+    if (last - first > 1)
+        insertionSort(values, first, last - 1, order, toShowState);
+}
+
+void blockQuickSort(vector<int>& values, const int order, const bool toShowState) {
+    if (values.empty() or sortIfMonotonic(values, scanRange(values), order))
+        return;
+
+    blockQuickSortLoop(values, 0, values.size(), introSortDepthLimit(values.size()), order, toShowState);
+}
+
+#endif
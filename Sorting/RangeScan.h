@@ -0,0 +1,175 @@
+/*
+    Range scan:
+    A single pass over the values that finds their minimum and maximum, and
+    whether they are already in ascending or in descending order. Counting
+    sort needs the range before it allocates anything, and with the order
+    known the sorts can skip their work on input that is already sorted, or
+    just reverse input that is sorted the other way round.
+
+    The pass is vectorized: 8 values at a time with AVX2, or 4 at a time
+    with SSE4.1, comparing each vector with the one starting a value later
+    for the order. Which one runs is chosen at runtime from what the CPU
+    supports, with a portable scalar loop as the fallback (and as the only
+    version on compilers or CPUs without these instructions).
+
+    Time complexity:
+    O(n), where n is the number of values
+
+    Space complexity:
+    O(1)
+*/
+
+#ifndef RANGE_SCAN_H
+#define RANGE_SCAN_H
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RANGE_SCAN_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+struct RangeScan {
+    int minValue;
+    int maxValue;
+    bool isAscending;   // no value is greater than the one after it
+    bool isDescending;  // no value is less than the one after it
+};
+
+// scans values[first, size) with scalar code, on top of what the vector code found before first
+void scanRangeScalar(const int* values, size_t first, const size_t size, RangeScan& scan) {
+    bool hasDescent = !scan.isAscending;
+    bool hasAscent = !scan.isDescending;
+
+    for (size_t i = first; i < size; i++) {
+        // the range, and in the same pass, the order of each value and the next
+        if (values[i] < scan.minValue)
+            scan.minValue = values[i];
+        if (values[i] > scan.maxValue)
+            scan.maxValue = values[i];
+
+        if (i + 1 < size) {
+            hasDescent = hasDescent or values[i] > values[i + 1];
+            hasAscent = hasAscent or values[i] < values[i + 1];
+        }
+    }
+
+    scan.isAscending = !hasDescent;
+    scan.isDescending = !hasAscent;
+}
+
+#ifdef RANGE_SCAN_X86
+
+__attribute__((target("avx2")))
+size_t scanRangeAVX2(const int* values, const size_t size, RangeScan& scan) {
+    if (size < 9)
+        return 0;
+
+    __m256i minimums = _mm256_set1_epi32(values[0]);
+    __m256i maximums = minimums;
+    __m256i descents = _mm256_setzero_si256();
+    __m256i ascents = _mm256_setzero_si256();
+
+    // each step compares values[i, i + 8) with values[i + 1, i + 9), so it stops
+    // while there is a value after the vector
+    size_t i = 0;
+    for (; i + 8 < size; i += 8) {
+        const __m256i current = _mm256_loadu_si256((const __m256i*) (values + i));
+        const __m256i next = _mm256_loadu_si256((const __m256i*) (values + i + 1));
+
+        minimums = _mm256_min_epi32(minimums, current);
+        maximums = _mm256_max_epi32(maximums, current);
+        descents = _mm256_or_si256(descents, _mm256_cmpgt_epi32(current, next));
+        ascents = _mm256_or_si256(ascents, _mm256_cmpgt_epi32(next, current));
+    }
+
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*) lanes, minimums);
+    scan.minValue = *min_element(lanes, lanes + 8);
+    _mm256_storeu_si256((__m256i*) lanes, maximums);
+    scan.maxValue = *max_element(lanes, lanes + 8);
+    scan.isAscending = _mm256_testz_si256(descents, descents);
+    scan.isDescending = _mm256_testz_si256(ascents, ascents);
+
+    return i;
+}
+
+__attribute__((target("sse4.1")))
+size_t scanRangeSSE4(const int* values, const size_t size, RangeScan& scan) {
+    if (size < 5)
+        return 0;
+
+    __m128i minimums = _mm_set1_epi32(values[0]);
+    __m128i maximums = minimums;
+    __m128i descents = _mm_setzero_si128();
+    __m128i ascents = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 4 < size; i += 4) {
+        const __m128i current = _mm_loadu_si128((const __m128i*) (values + i));
+        const __m128i next = _mm_loadu_si128((const __m128i*) (values + i + 1));
+
+        minimums = _mm_min_epi32(minimums, current);
+        maximums = _mm_max_epi32(maximums, current);
+        descents = _mm_or_si128(descents, _mm_cmpgt_epi32(current, next));
+        ascents = _mm_or_si128(ascents, _mm_cmpgt_epi32(next, current));
+    }
+
+    int lanes[4];
+    _mm_storeu_si128((__m128i*) lanes, minimums);
+    scan.minValue = *min_element(lanes, lanes + 4);
+    _mm_storeu_si128((__m128i*) lanes, maximums);
+    scan.maxValue = *max_element(lanes, lanes + 4);
+    scan.isAscending = _mm_testz_si128(descents, descents);
+    scan.isDescending = _mm_testz_si128(ascents, ascents);
+
+    return i;
+}
+
+#endif
+
+// the minimum and maximum of values[0, size), and whether they are in order (size > 0)
+RangeScan scanRange(const int* values, const size_t size) {
+    RangeScan scan = { values[0], values[0], true, true };
+    size_t scanned = 0;
+
+#ifdef RANGE_SCAN_X86
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    static const bool hasSSE4 = __builtin_cpu_supports("sse4.1");
+
+    if (hasAVX2)
+        scanned = scanRangeAVX2(values, size, scan);
+    else if (hasSSE4)
+        scanned = scanRangeSSE4(values, size, scan);
+#endif
+
+    scanRangeScalar(values, scanned, size, scan);
+    return scan;
+}
+
+RangeScan scanRange(const vector<int>& values) {
+    return scanRange(values.data(), values.size());
+}
+
+/*
+    Puts values in the given order if they already are in it, or in the
+    reverse one (by reversing them), and returns whether it did so, in which
+    case there is nothing left to sort.
+*/
+bool sortIfMonotonic(vector<int>& values, const RangeScan& scan, const int order) {
+    const bool isInOrder = order == 1 ? scan.isAscending : scan.isDescending;
+    const bool isInReverseOrder = order == 1 ? scan.isDescending : scan.isAscending;
+
+    if (isInOrder)
+        return true;
+    if (isInReverseOrder) {
+        reverse(values.begin(), values.end());
+        return true;
+    }
+    return false;
+}
+
+#endif
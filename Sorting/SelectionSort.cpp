@@ -6,35 +6,15 @@
 #include <iostream>
 #include <vector>
 
+#include "SelectionSort.h"
 #include "SortingUtils.h"
 
 using namespace std;
 
-void insertionSort(vector<int>& values, const int order, const bool toShowState) {
-    size_t i, j;
-
-    // index of either the current minimum or maximum value, depending on the order:
-    size_t currentExtremeIndex;
-
-    for (i = 0; i < values.size() - 1; i++) {
-        currentExtremeIndex = i;
-        j = i + 1;
-        while (j < values.size()) {
-            // 'order' is -1 for descending, so the inequality is reversed:
-            if (order * values[j] < order * values[currentExtremeIndex])
-                currentExtremeIndex = j;
-            j++;
-        }
-        swap(values[i], values[currentExtremeIndex]);
-
-        if (toShowState)
-            displayState(values);
-    }
-}
-
 int main() {
     size_t size;
-    getInputSize(size);
+    if (!getInputSize(size))
+        return EXIT_INPUT_SIZE_IS_ZERO;
 
     vector<int> values(size);
     getInputValues(values, size);
@@ -46,7 +26,7 @@ int main() {
     bool toShowState;
     getWhetherToShowState(toShowState);
 
-    insertionSort(values, order, toShowState);
+    selectionSort(values, order, toShowState);
 
     cout << "\nThe values in " << orderText << " order are :\n";
     displayState(values);
@@ -0,0 +1,42 @@
+/*
+    Selection sort:
+    A simple in-place comparision sorting algorithm
+
+    Time complexity:
+    O(n^2), where n is the number of values to sort
+
+    Space complexity:
+    O(1)
+*/
+
+#ifndef SELECTION_SORT_H
+#define SELECTION_SORT_H
+
+#include <vector>
+
+#include "SortingUtils.h"
+
+using namespace std;
+
+void selectionSort(vector<int>& values, const int order, const bool toShowState) {
+    size_t i, j;
+
+    // index of either the current minimum or maximum value, depending on the order:
+    size_t currentExtremeIndex;
+
+    for (i = 0; i + 1 < values.size(); i++) {
+        currentExtremeIndex = i;
+        j = i + 1;
+        while (j < values.size()) {
+            if (comesBefore(values[j], values[currentExtremeIndex], order))
+                currentExtremeIndex = j;
+            j++;
+        }
+        swap(values[i], values[currentExtremeIndex]);
+
+        if (toShowState)
+            displayState(values);
+    }
+}
+
+#endif
@@ -0,0 +1,356 @@
+/*
+    Sorting benchmark:
+    Runs every sort in this directory, calling it directly, on ints of seven
+    distributions (random, bounded to 16 bits, sorted, reversed, organ-pipe,
+    few unique values, and sorted with 1% noise) and sizes going up from 10
+    in powers of 10. It reports the time per value, the number of
+    comparisons, moves, swaps and memory allocations and the deepest
+    recursion of each run, and checks every result against std::sort.
+
+    Each run is repeated until it has taken at least MIN_TIMING_SECONDS
+    (so that small sizes are timed too), and its counts are those of its
+    first repetition. All but the allocations come from the sorts'
+    instrumentation (see SortingUtils.h), so they are counted only when
+    compiled with -DCOUNT_SORTING_OPERATIONS (which slows the sorts down a
+    little), and are shown as - otherwise, or for the sorts that do not report
+    them; allocations are always counted, by operator new.
+    The quadratic sorts only run up to QUADRATIC_MAX_SIZE values, and the
+    counting sorts only on ranges they can count.
+
+    Usage: ./SortingBenchmark.out [max size] [--csv file] [--json file]
+                                  [--input file [--format text|int32|int64]]
+    (10^7 by default, up to 10^8; the results also go to the CSV and JSON
+    files, if given. With --input, the values of the file are sorted instead
+    of the generated ones: decimal text by default, or raw little-endian
+    int32 or int64 values, which are mapped into memory)
+
+    (Compile with the -O2 and -pthread flags when using the CLI.)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BubbleSort.h"
+#include "CountingSort.h"
+#include "GenericSorting.h"
+#include "HeapSort.h"
+#include "InsertionSort.h"
+#include "MergeSort.h"
+#include "ParallelCountingSort.h"
+#include "ParallelMergeSort.h"
+#include "ParallelQuickSort.h"
+#include "QuickSort.h"
+#include "SelectionSort.h"
+#include "SortingUtils.h"
+#include "../Utils/FastInput.h"
+
+using namespace std;
+
+const size_t QUADRATIC_MAX_SIZE = 10000;
+const size_t CLASSIC_QUICK_SORT_MAX_SIZE = 100000;  // it is quadratic on few unique values
+const size_t UNLIMITED_SIZE = ~size_t(0);
+const double MIN_TIMING_SECONDS = 0.02;
+const size_t MAX_REPETITIONS = 1000;
+
+// memory allocations, counted by the global operator new below (which is not inlined,
+// nor is operator delete, for GCC not to mistake the malloc() and free() for a mismatch)
+atomic<unsigned long long> allocationCount(0);
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size > 0 ? size : 1))
+        return memory;
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+struct SortingAlgorithm {
+    string name;
+    function<void(vector<int>&)> sort;
+    size_t maxSize;
+    bool needsCountableRange;   // allocates memory for the whole range of the values
+    bool countsComparisons;     // compares through comesBefore(), so they can be counted
+    bool isInstrumented;        // reports its moves, swaps and recursion to SortingInstrumentation
+};
+
+struct InputDistribution {
+    string name;
+    function<void(vector<int>&, mt19937&)> fill;
+};
+
+struct BenchmarkResult {
+    size_t size;
+    string distribution;
+    string algorithm;
+    size_t repetitions;
+    double nanosecondsPerValue;
+    SortingStatistics statistics;
+    unsigned long long allocations;
+    bool countsComparisons;
+    bool isInstrumented;
+    bool isCorrect;
+};
+
+// the generic sorts compare through comesBefore too, so that their comparisons are counted
+bool countedAscending(const int a, const int b) {
+    return comesBefore(a, b, 1);
+}
+
+const vector<SortingAlgorithm> ALGORITHMS = {
+    { "bubbleSort", [](vector<int>& values) { bubbleSort(values, 1, false); }, QUADRATIC_MAX_SIZE, false, true, true },
+    { "selectionSort", [](vector<int>& values) { selectionSort(values, 1, false); }, QUADRATIC_MAX_SIZE, false, true, true },
+    { "insertionSort", [](vector<int>& values) { insertionSort(values, 1, false); }, QUADRATIC_MAX_SIZE, false, true, true },
+    { "heapSort", [](vector<int>& values) { heapSort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "quickSort", [](vector<int>& values) { quickSort(values, 0, values.size() - 1, 1, false); },
+      CLASSIC_QUICK_SORT_MAX_SIZE, false, true, true },
+    { "introSort", [](vector<int>& values) { introSort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "blockQuickSort", [](vector<int>& values) { blockQuickSort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "parallelQuickSort", [](vector<int>& values) { parallelQuickSort(values, 1); }, UNLIMITED_SIZE, false, true, true },
+    { "mergeSort", [](vector<int>& values) { mergeSort(values, 0, values.size() - 1, 1, false); },
+      UNLIMITED_SIZE, false, true, true },
+    { "pingPongMergeSort", [](vector<int>& values) { pingPongMergeSort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "bottomUpMergeSort", [](vector<int>& values) { bottomUpMergeSort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "parallelMergeSort", [](vector<int>& values) { parallelMergeSort(values, 1); }, UNLIMITED_SIZE, false, true, true },
+    { "counting_sort", [](vector<int>& values) { counting_sort(values, 1, false); }, UNLIMITED_SIZE, true, true, true },
+    { "radix_sort", [](vector<int>& values) { radix_sort(values, 1, false); }, UNLIMITED_SIZE, false, true, true },
+    { "parallel_counting_sort", [](vector<int>& values) { parallel_counting_sort(values, 1); },
+      UNLIMITED_SIZE, false, true, true },
+    { "quick_sort (generic)", [](vector<int>& values) { quick_sort(values.begin(), values.end(), countedAscending); },
+      UNLIMITED_SIZE, false, true, false },
+    { "merge_sort (generic)", [](vector<int>& values) { merge_sort(values.begin(), values.end(), countedAscending); },
+      UNLIMITED_SIZE, false, true, false },
+    { "insertion_sort (generic)",
+      [](vector<int>& values) { insertion_sort(values.begin(), values.end(), countedAscending); },
+      QUADRATIC_MAX_SIZE, false, true, false },
+    { "selection_sort (generic)",
+      [](vector<int>& values) { selection_sort(values.begin(), values.end(), countedAscending); },
+      QUADRATIC_MAX_SIZE, false, true, false },
+    { "bubble_sort (generic)", [](vector<int>& values) { bubble_sort(values.begin(), values.end(), countedAscending); },
+      QUADRATIC_MAX_SIZE, false, true, false },
+    { "counting_sort (generic)", [](vector<int>& values) { counting_sort(values.begin(), values.end()); },
+      UNLIMITED_SIZE, true, true, false },
+    { "std::sort", [](vector<int>& values) { sort(values.begin(), values.end()); }, UNLIMITED_SIZE, false, false, false },
+    { "std::stable_sort", [](vector<int>& values) { stable_sort(values.begin(), values.end()); },
+      UNLIMITED_SIZE, false, false, false },
+};
+
+const vector<InputDistribution> DISTRIBUTIONS = {
+    { "random", [](vector<int>& values, mt19937& generator) {
+        for (int& value : values)
+            value = generator();
+    } },
+    { "bounded", [](vector<int>& values, mt19937& generator) {
+        for (int& value : values)
+            value = generator() % 65536;   // 16-bit readings
+    } },
+    { "sorted", [](vector<int>& values, mt19937&) {
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = i;
+    } },
+    { "reversed", [](vector<int>& values, mt19937&) {
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = values.size() - i;
+    } },
+    { "organ-pipe", [](vector<int>& values, mt19937&) {     // ascending up to the middle, then descending
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = min(i, values.size() - i);
+    } },
+    { "few-unique", [](vector<int>& values, mt19937& generator) {
+        for (int& value : values)
+            value = generator() % 16;
+    } },
+    { "1%-noise", [](vector<int>& values, mt19937& generator) {     // sorted, with 1% of the values random
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = i;
+        for (size_t i = 0; i < values.size() / 100; i++)
+            values[generator() % values.size()] = generator() % values.size();
+    } },
+};
+
+// runs algorithm on input until it has taken MIN_TIMING_SECONDS, counting its first run
+BenchmarkResult runBenchmark(const SortingAlgorithm& algorithm, const vector<int>& input, const vector<int>& expected) {
+    BenchmarkResult result;
+    result.size = input.size();
+    result.algorithm = algorithm.name;
+    result.countsComparisons = algorithm.countsComparisons;
+    result.isInstrumented = algorithm.isInstrumented;
+    result.isCorrect = true;
+
+    double totalSeconds = 0;
+    size_t repetitions = 0;
+    vector<int> values;
+
+    while (repetitions == 0 or (totalSeconds < MIN_TIMING_SECONDS and repetitions < MAX_REPETITIONS)) {
+        values = input;
+
+        resetSortingStatistics();
+        const unsigned long long allocationsBefore = allocationCount;
+
+        const auto start = chrono::steady_clock::now();
+        algorithm.sort(values);
+        totalSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if (repetitions == 0) {
+            result.allocations = allocationCount - allocationsBefore;
+            result.statistics = sortingStatistics();
+            result.isCorrect = values == expected;
+        }
+        repetitions++;
+    }
+
+    result.repetitions = repetitions;
+    result.nanosecondsPerValue = totalSeconds * 1e9 / repetitions / input.size();
+    return result;
+}
+
+// a count, or notCounted when it is not counted
+string countText(const unsigned long long count, const bool isCounted, const string& notCounted = "-") {
+    return isCounted ? to_string(count) : notCounted;
+}
+
+void writeCSV(const string& path, const vector<BenchmarkResult>& results) {
+    ofstream output(path);
+    output << "size,distribution,algorithm,repetitions,ns_per_value,comparisons,moves,swaps,recursion_depth,"
+           << "allocations,correct\n";
+    for (const BenchmarkResult& result : results) {
+        const SortingStatistics& statistics = result.statistics;
+        const bool isCounted = IS_SORTING_INSTRUMENTED;
+
+        output << result.size << "," << result.distribution << "," << result.algorithm << ","
+               << result.repetitions << "," << result.nanosecondsPerValue << ","
+               << countText(statistics.comparisons, isCounted and result.countsComparisons, "") << ","
+               << countText(statistics.moves, isCounted and result.isInstrumented, "") << ","
+               << countText(statistics.swaps, isCounted and result.isInstrumented, "") << ","
+               << countText(statistics.maxRecursionDepth, isCounted and result.isInstrumented, "") << ","
+               << result.allocations << "," << (result.isCorrect ? "true" : "false") << "\n";
+    }
+}
+
+void writeJSON(const string& path, const vector<BenchmarkResult>& results) {
+    ofstream output(path);
+    output << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        const SortingStatistics& statistics = result.statistics;
+        const bool isCounted = IS_SORTING_INSTRUMENTED;
+
+        output << "  { \"size\": " << result.size
+               << ", \"distribution\": \"" << result.distribution << "\""
+               << ", \"algorithm\": \"" << result.algorithm << "\""
+               << ", \"repetitions\": " << result.repetitions
+               << ", \"ns_per_value\": " << result.nanosecondsPerValue
+               << ", \"comparisons\": " << countText(statistics.comparisons, isCounted and result.countsComparisons, "null")
+               << ", \"moves\": " << countText(statistics.moves, isCounted and result.isInstrumented, "null")
+               << ", \"swaps\": " << countText(statistics.swaps, isCounted and result.isInstrumented, "null")
+               << ", \"recursion_depth\": "
+               << countText(statistics.maxRecursionDepth, isCounted and result.isInstrumented, "null")
+               << ", \"allocations\": " << result.allocations
+               << ", \"correct\": " << (result.isCorrect ? "true" : "false")
+               << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    output << "]\n";
+}
+
+// runs every algorithm that can sort input on it, printing and collecting the results; false if any was wrong
+bool benchmarkInput(const vector<int>& input, const string& distributionName, vector<BenchmarkResult>& results) {
+    if (input.empty())
+        return true;
+
+    vector<int> expected(input);
+    sort(expected.begin(), expected.end());
+
+    const size_t size = input.size();
+    const size_t range = (long long) expected.back() - expected.front() + 1;
+    const bool isRangeCountable = range <= max(size, MIN_COUNTING_RANGE);
+
+    bool allCorrect = true;
+    for (const SortingAlgorithm& algorithm : ALGORITHMS) {
+        if (size > algorithm.maxSize or (algorithm.needsCountableRange and !isRangeCountable))
+            continue;
+
+        BenchmarkResult result = runBenchmark(algorithm, input, expected);
+        result.distribution = distributionName;
+        results.push_back(result);
+        allCorrect = allCorrect and result.isCorrect;
+
+        const SortingStatistics& statistics = result.statistics;
+        const bool isCounted = IS_SORTING_INSTRUMENTED;
+
+        cout << left << setw(12) << size << setw(12) << distributionName << setw(28) << algorithm.name
+             << right << fixed << setw(12) << setprecision(2) << result.nanosecondsPerValue
+             << setw(16) << countText(statistics.comparisons, isCounted and result.countsComparisons)
+             << setw(16) << countText(statistics.moves, isCounted and result.isInstrumented)
+             << setw(16) << countText(statistics.swaps, isCounted and result.isInstrumented)
+             << setw(8) << countText(statistics.maxRecursionDepth, isCounted and result.isInstrumented)
+             << setw(14) << result.allocations
+             << (result.isCorrect ? "" : "   WRONG!") << endl;
+    }
+    return allCorrect;
+}
+
+int main(int argc, char* argv[]) {
+    size_t maxSize = 10000000;
+    string csvPath, jsonPath, inputPath, inputFormat = "text";
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0 and i + 1 < argc)
+            csvPath = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 and i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--input") == 0 and i + 1 < argc)
+            inputPath = argv[++i];
+        else if (strcmp(argv[i], "--format") == 0 and i + 1 < argc)
+            inputFormat = argv[++i];
+        else
+            maxSize = strtoull(argv[i], nullptr, 10);
+    }
+
+    vector<int> fileInput;
+    if (!inputPath.empty()) {
+        string error;
+        if (!loadIntegers(inputPath, inputFormat, fileInput, error)) {
+            cout << "Could not load the input: " << error << "\n";
+            return 2;
+        }
+    }
+
+    mt19937 generator(2017);
+    vector<BenchmarkResult> results;
+    bool allCorrect = true;
+
+    cout << left << setw(12) << "size" << setw(12) << "input" << setw(28) << "algorithm"
+         << right << setw(12) << "ns/value" << setw(16) << "comparisons" << setw(16) << "moves"
+         << setw(16) << "swaps" << setw(8) << "depth" << setw(14) << "allocations" << "\n";
+
+    if (!inputPath.empty()) {
+        allCorrect = benchmarkInput(fileInput, "file", results);
+    } else {
+        for (size_t size = 10; size <= maxSize; size *= 10) {
+            for (const InputDistribution& distribution : DISTRIBUTIONS) {
+                vector<int> input(size);
+                distribution.fill(input, generator);
+                allCorrect = benchmarkInput(input, distribution.name, results) and allCorrect;
+            }
+        }
+    }
+
+    if (!csvPath.empty())
+        writeCSV(csvPath, results);
+    if (!jsonPath.empty())
+        writeJSON(jsonPath, results);
+
+    return allCorrect ? 0 : 1;
+}
@@ -3,40 +3,56 @@
     used in programs that implement sorting algorithms
 */
 
+#ifndef SORTING_UTILS_H
+#define SORTING_UTILS_H
+
+#include <algorithm>    // for fill()
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <vector>
 
+#include "../Utils/BufferedWriter.h"
+#include "../Utils/FastInput.h"
+
 #define EXIT_INPUT_SIZE_IS_ZERO 2    // exit code for when input size is 0
 
 using namespace std;
 
 // Input utils:
+// (all of the input is read through standardInput(), and the prompts are
+// shown only when it is typed in, so that values can be piped in as well)
 
-void getInputSize(size_t& size) {
-    cout << "Enter the input size : ";
-    cin >> size;
+// false if there is nothing to sort, for the driver to exit with EXIT_INPUT_SIZE_IS_ZERO
+bool getInputSize(size_t& size) {
+    prompt("Enter the input size : ");
+    long long answer;
+    if (!standardInput().read(answer))
+        answer = 0;
 
-    if ((int) size < 0) {
+    if (answer < 0) {
         cout << "Invalid input size! Try again.\n";
-        getInputSize(size);
-    } else if (size == 0) {
+        return getInputSize(size);
+    } else if (answer == 0) {
         cout << "Nothing to sort here.\n";
-        exit(EXIT_INPUT_SIZE_IS_ZERO);
+        return false;
     }
+
+    size = answer;
+    return true;
 }
 
 void getInputValues(vector<int>& values, const size_t& size) {
-    cout << "\nEnter " << size << " integers :\n";
-    for (int& val: values)
-        cin >> val;
-    cin.ignore();
+    prompt("\nEnter " + to_string(size) + " integers :\n");
+    const size_t readCount = standardInput().read_all(values.data(), size);
+    fill(values.begin() + readCount, values.end(), 0);     // the values missing from the input
+    standardInput().skip_line();
 }
 
 void getOrder(int& order, string& orderText ) {
-    cout << "\nSorting order?\n";
-    cout << "[A]scending / [d]escending : ";
-    getline(cin, orderText);
+    prompt("\nSorting order?\n[A]scending / [d]escending : ");
+    standardInput().read_line(orderText);
 
     if (orderText[0] == 'd' or orderText[0] == 'D') {
         order = -1;
@@ -47,11 +63,24 @@ void getOrder(int& order, string& orderText ) {
     }
 }
 
+// lets the user pick one of the variants of an algorithm, the first one by default
+void getVariant(size_t& variant, const vector<string>& variantNames) {
+    string answer;
+    string options = "\nWhich variant?\n";
+    for (size_t i = 0; i < variantNames.size(); i++)
+        options += "[" + to_string(i + 1) + "] " + variantNames[i] + "\n";
+    prompt(options + "Variant (default 1) : ");
+    standardInput().read_line(answer);
+
+    variant = 0;
+    if (!answer.empty() and answer[0] >= '1' and answer[0] < char('1' + variantNames.size()))
+        variant = answer[0] - '1';
+}
+
 void getWhetherToShowState(bool& toShowState) {
     string answer;
-    cout << "\nShow state of values after each iteration?\n";
-    cout << "[y]es / [N]o : ";
-    getline(cin, answer);
+    prompt("\nShow state of values after each iteration?\n[y]es / [N]o : ");
+    standardInput().read_line(answer);
 
     toShowState = false;        // by default, don't show state
     if (answer[0] == 'y' or answer[0] == 'Y')    // unless user asks for it
@@ -61,15 +90,134 @@ void getWhetherToShowState(bool& toShowState) {
 // Output utils:
 
 void displayState(const vector<int>& values) {
+    // one writer for all the states, which can be many (one per pass)
+    static BufferedWriter output;
+    cout.flush();
     for (const int& val: values)
-        cout << val << ' ';
-    cout << '\n';
+        output << val << ' ';
+    output << '\n';
+    output.flush();
 }
 
 // Other utils:
 
+/*
+    Instrumentation:
+    What the sorts do (comparisons, moves and swaps of values, their deepest
+    recursion and the temporary vectors they allocate) is reported to the
+    policy SortingInstrumentation, picked at compile time. By default it is
+    NoInstrumentation, whose functions are empty and compile to nothing, so
+    the sorts pay nothing for it; compiled with -DCOUNT_SORTING_OPERATIONS
+    (as SortingBenchmark can be, for its counts), it is
+    CountingInstrumentation, which counts them all into a SortingStatistics
+    summary.
+
+    Usage:
+        resetSortingStatistics();
+        mergeSort(values, 0, values.size() - 1, 1, false);
+        SortingStatistics statistics = sortingStatistics();
+*/
+
+struct SortingStatistics {
+    unsigned long long comparisons;
+    unsigned long long moves;           // of single values, not counting those of swaps
+    unsigned long long swaps;
+    unsigned long long allocations;     // temporary vectors
+    unsigned long long allocatedBytes;
+    unsigned long long maxRecursionDepth;
+};
+
+struct NoInstrumentation {
+    static void compared() {}
+    static void moved(const size_t) {}
+    static void swapped() {}
+    static void allocated(const size_t) {}
+
+    // one level of recursion, for as long as it exists
+    struct RecursionLevel {
+        RecursionLevel() {}     // (user-provided, so that unused instances raise no warnings)
+    };
+
+    static SortingStatistics statistics() { return SortingStatistics { 0, 0, 0, 0, 0, 0 }; }
+    static void reset() {}
+};
+
+class CountingInstrumentation {
+private:
+    static atomic<unsigned long long>& counter(const size_t index) {
+        static atomic<unsigned long long> counters[6];
+        return counters[index];
+    }
+
+    static unsigned long long& depth() {     // of the calling thread
+        static thread_local unsigned long long currentDepth = 0;
+        return currentDepth;
+    }
+
+    static void add(const size_t index, const unsigned long long count) {
+        counter(index).fetch_add(count, memory_order_relaxed);
+    }
+
+public:
+    enum { COMPARISONS, MOVES, SWAPS, ALLOCATIONS, ALLOCATED_BYTES, MAX_RECURSION_DEPTH };
+
+    static void compared() { add(COMPARISONS, 1); }
+    static void moved(const size_t count) { add(MOVES, count); }
+    static void swapped() { add(SWAPS, 1); }
+    static void allocated(const size_t bytes) {
+        add(ALLOCATIONS, 1);
+        add(ALLOCATED_BYTES, bytes);
+    }
+
+    struct RecursionLevel {
+        RecursionLevel() {
+            const unsigned long long newDepth = ++depth();
+            unsigned long long maxDepth = counter(MAX_RECURSION_DEPTH);
+            while (newDepth > maxDepth and !counter(MAX_RECURSION_DEPTH).compare_exchange_weak(maxDepth, newDepth)) {}
+        }
+        ~RecursionLevel() { --depth(); }
+    };
+
+    static SortingStatistics statistics() {
+        return SortingStatistics { counter(COMPARISONS), counter(MOVES), counter(SWAPS), counter(ALLOCATIONS),
+                                   counter(ALLOCATED_BYTES), counter(MAX_RECURSION_DEPTH) };
+    }
+
+    static void reset() {
+        for (size_t i = COMPARISONS; i <= MAX_RECURSION_DEPTH; i++)
+            counter(i) = 0;
+    }
+};
+
+#ifdef COUNT_SORTING_OPERATIONS
+typedef CountingInstrumentation SortingInstrumentation;
+const bool IS_SORTING_INSTRUMENTED = true;
+#else
+typedef NoInstrumentation SortingInstrumentation;
+const bool IS_SORTING_INSTRUMENTED = false;
+#endif
+
+// what the sorts did since the last reset (all zeros unless they are instrumented)
+SortingStatistics sortingStatistics() {
+    return SortingInstrumentation::statistics();
+}
+
+void resetSortingStatistics() {
+    SortingInstrumentation::reset();
+}
+
+// whether a should come before b in the given order ('order' is -1 for descending, 1 for ascending),
+// without multiplying by 'order', which would overflow for INT_MIN
+bool comesBefore(const int a, const int b, const int order) {
+    SortingInstrumentation::compared();
+    return order == -1 ? b < a : a < b;
+}
+
 void swap(int& a, int& b) {
+    SortingInstrumentation::swapped();
     int temp = a;
     a = b;
     b = temp;
 }
+
+#endif
@@ -217,18 +217,19 @@ bool BinarySearchTree::search(int value) {
     O(n), where n is the number if nodes in the tree
 */
 
-void BinarySearchTree::traversal_inorder_helper(Node* tree) {
+void BinarySearchTree::traversal_inorder_helper(Node* tree, BufferedWriter& output) {
     if (tree == nullptr or tree->value == INF) {
         return;
     }
 
-    traversal_inorder_helper(tree->left_child);
-    cout << tree->value << endl;
-    traversal_inorder_helper(tree->right_child);
+    traversal_inorder_helper(tree->left_child, output);
+    output << tree->value << '\n';
+    traversal_inorder_helper(tree->right_child, output);
 }
 
 void BinarySearchTree::traversal_inorder_recursive()  {
-    traversal_inorder_helper(root);
+    BufferedWriter output;
+    traversal_inorder_helper(root, output);
 }
 
 void BinarySearchTree::traversal_inorder_iterative() {
@@ -236,6 +237,7 @@ void BinarySearchTree::traversal_inorder_iterative() {
         return;
     }
 
+    BufferedWriter output;
     stack<Node*> traversal;
     Node* current = root;
     bool complete = false;
@@ -247,7 +249,7 @@ void BinarySearchTree::traversal_inorder_iterative() {
         } else if (!traversal.empty()) {
             current = traversal.top();
             traversal.pop();
-            cout << current->value << endl;
+            output << current->value << '\n';
             current = current->right_child;
         } else {
             complete = true;
@@ -269,18 +271,19 @@ void BinarySearchTree::traversal_inorder_iterative() {
     O(n), where n is the number if nodes in the tree
 */
 
-void BinarySearchTree::traversal_preorder_helper(Node* tree) {
+void BinarySearchTree::traversal_preorder_helper(Node* tree, BufferedWriter& output) {
     if (tree == nullptr or tree->value == INF) {
         return;
     }
 
-    cout << tree->value << endl;
-    traversal_preorder_helper(tree->left_child);
-    traversal_preorder_helper(tree->right_child);
+    output << tree->value << '\n';
+    traversal_preorder_helper(tree->left_child, output);
+    traversal_preorder_helper(tree->right_child, output);
 }
 
 void BinarySearchTree::traversal_preorder_recursive() {
-    traversal_preorder_helper(root);
+    BufferedWriter output;
+    traversal_preorder_helper(root, output);
 }
 
 void BinarySearchTree::traversal_preorder_iterative() {
@@ -288,6 +291,7 @@ void BinarySearchTree::traversal_preorder_iterative() {
         return;
     }
 
+    BufferedWriter output;
     stack<Node*> traversal;
     Node* current;
 
@@ -296,7 +300,7 @@ void BinarySearchTree::traversal_preorder_iterative() {
     while (!traversal.empty()) {
         current = traversal.top();
         traversal.pop();
-        cout << current->value << endl;
+        output << current->value << '\n';
 
         if (current->right_child != nullptr) {
             traversal.push(current->right_child);
@@ -322,18 +326,19 @@ void BinarySearchTree::traversal_preorder_iterative() {
     O(n), where n is the number if nodes in the tree
 */
 
-void BinarySearchTree::traversal_postorder_helper(Node* tree) {
+void BinarySearchTree::traversal_postorder_helper(Node* tree, BufferedWriter& output) {
     if (tree == nullptr or tree->value == INF) {
         return;
     } else {
-        traversal_postorder_helper(tree->left_child);
-        traversal_postorder_helper(tree->right_child);
-        cout << tree->value << endl;
+        traversal_postorder_helper(tree->left_child, output);
+        traversal_postorder_helper(tree->right_child, output);
+        output << tree->value << '\n';
     }
 }
 
 void BinarySearchTree::traversal_postorder_recursive() {
-    traversal_postorder_helper(root);
+    BufferedWriter output;
+    traversal_postorder_helper(root, output);
 }
 
 void BinarySearchTree::traversal_postorder_iterative() {
@@ -341,6 +346,7 @@ void BinarySearchTree::traversal_postorder_iterative() {
         return;
     }
 
+    BufferedWriter output;
     stack<Node*> traversal;
     Node* current = root;
 
@@ -366,7 +372,7 @@ void BinarySearchTree::traversal_postorder_iterative() {
             traversal.push(current);
             current= current->right_child;
         } else {
-            cout << current->value << endl;
+            output << current->value << '\n';
             current = nullptr;
         }
     } while (!traversal.empty());
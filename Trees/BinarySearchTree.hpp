@@ -1,7 +1,10 @@
-#include <climits>
 #ifndef BINARY_SEARCH_TREE
 #define BINARY_SEARCH_TREE
 
+#include <climits>
+
+#include "../Utils/BufferedWriter.h"
+
 const int INF = INT_MAX;
 
 struct Node {
@@ -17,9 +20,9 @@ private:
     Node* root;
 
     void remove_current_node(Node* current, Node* parent);
-    void traversal_inorder_helper(Node* tree);
-    void traversal_preorder_helper(Node* tree);
-    void traversal_postorder_helper(Node* tree);
+    void traversal_inorder_helper(Node* tree, BufferedWriter& output);
+    void traversal_preorder_helper(Node* tree, BufferedWriter& output);
+    void traversal_postorder_helper(Node* tree, BufferedWriter& output);
 
 public:
 
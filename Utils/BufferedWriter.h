@@ -0,0 +1,139 @@
+/*
+    Buffered writer:
+    A fast output path for programs that print many integers. Integers are
+    formatted into a large buffer two digits at a time, and the buffer is
+    handed to the C library with a single fwrite each time it fills up,
+    instead of going through a formatted stream insert per value.
+
+    Usage:
+        BufferedWriter output;
+        output << value << ' ';     // flushed when output goes out of scope
+
+    Time complexity:
+    O(D) per integer, where D is the number of its digits
+
+    Space complexity:
+    O(B), where B is the size of the buffer
+*/
+
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+const size_t DEFAULT_WRITE_BUFFER_SIZE = 1 << 20;   // 1 MiB
+
+// "00", "01", ..., "99", so that digits can be written two at a time
+const char DIGIT_PAIRS[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+const size_t MAX_INTEGER_LENGTH = 20;   // digits in 2^64 - 1, or a sign and the digits of 2^63
+
+class BufferedWriter {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t used;
+
+    void make_room(const size_t length) {
+        if (used + length > buffer.size())
+            flush();
+    }
+
+    void write_unsigned(unsigned long long value) {
+        char digits[20];
+        char* start = digits + sizeof(digits);
+
+        while (value >= 100) {
+            start -= 2;
+            memcpy(start, DIGIT_PAIRS + 2 * (value % 100), 2);
+            value /= 100;
+        }
+        if (value >= 10) {
+            start -= 2;
+            memcpy(start, DIGIT_PAIRS + 2 * value, 2);
+        } else {
+            *--start = '0' + value;
+        }
+
+        const size_t length = digits + sizeof(digits) - start;
+        memcpy(buffer.data() + used, start, length);
+        used += length;
+    }
+
+public:
+    // flushes cout first, so that whatever was printed before stays before
+    explicit BufferedWriter(FILE* file = stdout, const size_t bufferSize = DEFAULT_WRITE_BUFFER_SIZE)
+        : file(file), buffer(bufferSize < 64 ? 64 : bufferSize), used(0) {
+        cout.flush();
+    }
+
+    ~BufferedWriter() { flush(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void flush() {
+        if (used > 0)
+            fwrite(buffer.data(), 1, used, file);
+        used = 0;
+        fflush(file);
+    }
+
+    void write(const char* text, const size_t length) {
+        if (length > buffer.size()) {   // too long to buffer, write it directly
+            flush();
+            fwrite(text, 1, length, file);
+            return;
+        }
+
+        make_room(length);
+        memcpy(buffer.data() + used, text, length);
+        used += length;
+    }
+
+    BufferedWriter& operator<<(const char character) {
+        make_room(1);
+        buffer[used++] = character;
+        return *this;
+    }
+
+    BufferedWriter& operator<<(const char* text) {
+        write(text, strlen(text));
+        return *this;
+    }
+
+    BufferedWriter& operator<<(const string& text) {
+        write(text.data(), text.size());
+        return *this;
+    }
+
+    // any integer type other than char
+    template <typename Integer>
+    typename enable_if<is_integral<Integer>::value, BufferedWriter&>::type operator<<(const Integer value) {
+        make_room(MAX_INTEGER_LENGTH);
+
+        if (value < Integer(0)) {
+            buffer[used++] = '-';
+            // negate in unsigned arithmetic, so that the smallest value does not overflow
+            write_unsigned(0ULL - (unsigned long long) value);
+        } else {
+            write_unsigned(value);
+        }
+
+        return *this;
+    }
+};
+
+#endif
@@ -0,0 +1,442 @@
+/*
+    Fast input:
+    Fast input paths for programs that read many integers, the counterpart
+    of BufferedWriter.
+
+    BufferedReader reads large blocks from a file (stdin by default), and
+    parses the integers in them by hand, a digit at a time, instead of going
+    through a formatted stream extraction per value. On a terminal each
+    block is as much as has been typed, so it also serves interactive
+    programs; all of a program's input must then go through the one reader
+    (standardInput() for stdin), since it reads ahead of what it has parsed.
+
+    MappedIntegerFile gives access to a raw file of little-endian int32_t or
+    int64_t values without reading it: the file is mapped into memory, and
+    the values are used in place (read into memory instead where mmap is not
+    available, or the machine is big-endian).
+
+    isInteractive tells whether stdin is a terminal, and prompt shows a prompt
+    only then, so that programs ask for their input when it is typed in, and
+    read piped input silently.
+
+    Usage:
+        BufferedReader& input = standardInput();
+        int value;
+        while (input.read(value)) { ... }
+
+        MappedIntegerFile<int32_t> file;
+        if (file.open("values.bin", error)) { ... file.data()[i] ... }
+
+    Time complexity:
+    O(D) per integer read, where D is the number of its characters; O(1) to
+    map a file
+
+    Space complexity:
+    O(B), where B is the size of the buffer; O(1) for a mapped file (besides
+    the mapping itself)
+*/
+
+#ifndef FAST_INPUT_H
+#define FAST_INPUT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FAST_INPUT_USE_POSIX
+#endif
+
+using namespace std;
+
+const size_t DEFAULT_READ_BUFFER_SIZE = 1 << 20;    // 1 MiB
+
+class BufferedReader {
+private:
+    FILE* file;
+    vector<char> buffer;
+    size_t position;    // of the next character to parse
+    size_t length;      // of the data in the buffer
+    bool isAtEnd;
+
+    // reads the next block, after the kept characters left at the start of the buffer; false at the end of the input
+    bool refill(const size_t kept = 0) {
+        position = 0;
+        length = kept;
+        if (isAtEnd)
+            return false;
+
+#ifdef FAST_INPUT_USE_POSIX
+        // read() returns what is available, instead of waiting for a full buffer
+        const ssize_t count = ::read(fileno(file), buffer.data() + kept, buffer.size() - kept);
+        length += count > 0 ? count : 0;
+#else
+        length += fgets(buffer.data() + kept, buffer.size() - kept, file) != nullptr ? strlen(buffer.data() + kept) : 0;
+#endif
+        isAtEnd = length == kept;
+        return !isAtEnd;
+    }
+
+    // the next character, without consuming it; EOF at the end of the input
+    int peek() {
+        if (position == length and !refill())
+            return EOF;
+        return (unsigned char) buffer[position];
+    }
+
+    // the character after the next one (a sign), without consuming either; EOF at the end of the input
+    int peek_after_sign() {
+        if (position + 1 == length) {
+            buffer[0] = buffer[position];   // keep the sign, and read more after it
+            if (!refill(1))
+                return EOF;
+        }
+        return (unsigned char) buffer[position + 1];
+    }
+
+    static bool is_digit(const int character) {
+        return character >= '0' and character <= '9';
+    }
+
+    static bool is_space(const int character) {
+        return character == ' ' or character == '\n' or character == '\t' or character == '\r'
+            or character == '\v' or character == '\f';
+    }
+
+public:
+    explicit BufferedReader(FILE* file = stdin, const size_t size = DEFAULT_READ_BUFFER_SIZE)
+        : file(file), buffer(size < 64 ? 64 : size), position(0), length(0), isAtEnd(false) {}
+
+    // skips whitespace; false if there is nothing but whitespace left
+    bool skip_whitespace() {
+        int character;
+        while ((character = peek()) != EOF and is_space(character))
+            position++;
+        return character != EOF;
+    }
+
+    // skips the rest of the current line, and its end
+    void skip_line() {
+        int character;
+        while ((character = peek()) != EOF) {
+            position++;
+            if (character == '\n')
+                return;
+        }
+    }
+
+    // reads the next (optionally signed) decimal integer; false if there is none, or if it does not
+    // fit in Integer (which leaves its digits from the first one that overflows unread)
+    template <typename Integer>
+    bool read(Integer& value) {
+        static_assert(is_integral<Integer>::value, "BufferedReader::read needs an integral type");
+
+        if (!skip_whitespace())
+            return false;
+
+        // the sign is consumed only if a digit follows it, so that a malformed token is left unread
+        const bool isNegative = buffer[position] == '-';
+        if (isNegative or buffer[position] == '+') {
+            if (!is_digit(peek_after_sign()))
+                return false;
+            position++;
+        }
+
+        int character = peek();
+        if (!is_digit(character))
+            return false;
+
+        // the largest magnitude Integer holds with this sign (none but 0, if it is negative and unsigned)
+        unsigned long long limit = numeric_limits<Integer>::max();
+        if (isNegative)
+            limit = is_signed<Integer>::value ? limit + 1 : 0;
+
+        // in unsigned arithmetic, which wraps around like the two's complement of the result
+        unsigned long long magnitude = 0;
+        do {
+            const unsigned digit = character - '0';
+            if (magnitude > limit / 10 or (magnitude == limit / 10 and digit > limit % 10))
+                return false;
+            magnitude = magnitude * 10 + digit;
+            position++;
+            character = peek();
+        } while (is_digit(character));
+
+        value = Integer(isNegative ? 0 - magnitude : magnitude);
+        return true;
+    }
+
+    // reads the next word (up to whitespace); false if there is none
+    bool read(string& word) {
+        word.clear();
+        if (!skip_whitespace())
+            return false;
+
+        int character;
+        while ((character = peek()) != EOF and !is_space(character)) {
+            word += char(character);
+            position++;
+        }
+        return true;
+    }
+
+    bool read(double& value) {
+        string word;
+        if (!read(word))
+            return false;
+
+        char* end;
+        value = strtod(word.c_str(), &end);
+        return end != word.c_str();
+    }
+
+    // reads the rest of the current line, without its end; false at the end of the input
+    bool read_line(string& line) {
+        line.clear();
+        int character = peek();
+        if (character == EOF)
+            return false;
+
+        while ((character = peek()) != EOF) {
+            position++;
+            if (character == '\n')
+                break;
+            line += char(character);
+        }
+        if (!line.empty() and line.back() == '\r')
+            line.pop_back();
+        return true;
+    }
+
+    // reads integers into values until it is full, or the input ends; returns how many were read
+    template <typename Integer>
+    size_t read_all(Integer* values, const size_t count) {
+        size_t read_count = 0;
+        while (read_count < count and read(values[read_count]))
+            read_count++;
+        return read_count;
+    }
+
+    // reads all the integers left in the input
+    template <typename Integer>
+    void read_all(vector<Integer>& values) {
+        Integer value;
+        while (read(value))
+            values.push_back(value);
+    }
+};
+
+// the reader of stdin, shared by everything that reads it
+BufferedReader& standardInput() {
+    static BufferedReader reader(stdin);
+    return reader;
+}
+
+// whether stdin is a terminal (a person typing, who needs prompts), rather than a pipe or a file
+bool isInteractive() {
+#ifdef FAST_INPUT_USE_POSIX
+    static const bool isTerminal = isatty(fileno(stdin));
+    return isTerminal;
+#else
+    return true;
+#endif
+}
+
+// shows text to the user, if there is one to see it
+void prompt(const string& text) {
+    if (isInteractive())
+        cout << text << flush;
+}
+
+bool isLittleEndian() {
+    const uint16_t one = 1;
+    unsigned char firstByte;
+    memcpy(&firstByte, &one, 1);
+    return firstByte == 1;
+}
+
+template <typename Integer>
+Integer fromLittleEndian(Integer value) {
+    unsigned char bytes[sizeof(Integer)];
+    memcpy(bytes, &value, sizeof(Integer));
+
+    typename make_unsigned<Integer>::type result = 0;
+    for (size_t i = sizeof(Integer); i-- > 0; )
+        result = (result << 8) | bytes[i];
+    return Integer(result);
+}
+
+template <typename Integer>
+class MappedIntegerFile {
+private:
+    const Integer* values;
+    size_t count;
+    void* mapping;          // when the file is mapped
+    size_t mappingLength;
+    vector<Integer> copy;   // when it is read instead
+
+    MappedIntegerFile(const MappedIntegerFile&) = delete;
+    MappedIntegerFile& operator=(const MappedIntegerFile&) = delete;
+
+    bool read_file(const string& path, string& error) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            error = "could not open " + path;
+            return false;
+        }
+
+        fseek(file, 0, SEEK_END);
+        const long bytes = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (bytes < 0 or bytes % sizeof(Integer) != 0) {
+            fclose(file);
+            error = path + " is not a whole number of " + to_string(sizeof(Integer)) + "-byte values";
+            return false;
+        }
+
+        copy.resize(bytes / sizeof(Integer));
+        const size_t readCount = fread(copy.data(), sizeof(Integer), copy.size(), file);
+        fclose(file);
+        if (readCount != copy.size()) {
+            error = "could not read " + path;
+            return false;
+        }
+
+        if (!isLittleEndian())
+            for (Integer& value : copy)
+                value = fromLittleEndian(value);
+
+        values = copy.data();
+        count = copy.size();
+        return true;
+    }
+
+public:
+    static_assert(is_integral<Integer>::value, "MappedIntegerFile needs an integral type");
+
+    MappedIntegerFile() : values(nullptr), count(0), mapping(nullptr), mappingLength(0) {}
+    ~MappedIntegerFile() { close(); }
+
+    bool open(const string& path, string& error) {
+        close();
+
+#ifdef FAST_INPUT_USE_POSIX
+        if (isLittleEndian()) {
+            const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+            if (fileDescriptor < 0) {
+                error = "could not open " + path;
+                return false;
+            }
+
+            struct stat fileStatus;
+            if (fstat(fileDescriptor, &fileStatus) != 0 or fileStatus.st_size % sizeof(Integer) != 0) {
+                ::close(fileDescriptor);
+                error = path + " is not a whole number of " + to_string(sizeof(Integer)) + "-byte values";
+                return false;
+            }
+
+            if (fileStatus.st_size == 0) {   // nothing to map
+                ::close(fileDescriptor);
+                return true;
+            }
+
+            void* fileMapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            ::close(fileDescriptor);    // the mapping stays valid
+            if (fileMapping != MAP_FAILED) {
+                mapping = fileMapping;
+                mappingLength = fileStatus.st_size;
+                values = static_cast<const Integer*>(mapping);
+                count = mappingLength / sizeof(Integer);
+                return true;
+            }
+        }
+#endif
+
+        return read_file(path, error);
+    }
+
+    void close() {
+#ifdef FAST_INPUT_USE_POSIX
+        if (mapping != nullptr)
+            munmap(mapping, mappingLength);
+#endif
+        mapping = nullptr;
+        mappingLength = 0;
+        copy.clear();
+        copy.shrink_to_fit();
+        values = nullptr;
+        count = 0;
+    }
+
+    const Integer* data() const { return values; }
+    size_t size() const { return count; }
+    const Integer* begin() const { return values; }
+    const Integer* end() const { return values + count; }
+};
+
+// copies the values of a raw file of Stored values into values, if they all fit
+template <typename Stored, typename Integer>
+bool copyMappedIntegers(const string& path, vector<Integer>& values, string& error) {
+    MappedIntegerFile<Stored> file;
+    if (!file.open(path, error))
+        return false;
+
+    values.reserve(file.size());
+    for (const Stored& value : file) {
+        if (Stored(Integer(value)) != value or (Integer(value) < 0) != (value < 0)) {
+            error = path + " has a value (" + to_string(value) + ") out of range";
+            values.clear();
+            return false;
+        }
+        values.push_back(Integer(value));
+    }
+    return true;
+}
+
+/*
+    Loads all the integers of a file into values, whatever its format: "text"
+    (decimal, separated by whitespace), or raw little-endian "int32" or
+    "int64". Values that do not fit in Integer are an error, as is anything
+    in a text file that is not an integer.
+*/
+template <typename Integer>
+bool loadIntegers(const string& path, const string& format, vector<Integer>& values, string& error) {
+    values.clear();
+
+    if (format == "text") {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            error = "could not open " + path;
+            return false;
+        }
+        BufferedReader reader(file);
+        reader.read_all(values);
+        // read_all stops at the end of the file, or at a value it can't read, which is still there
+        const bool isMalformed = reader.skip_whitespace();
+        fclose(file);
+        if (isMalformed)
+            error = "malformed or out of range value in " + path;
+        return !isMalformed;
+    }
+
+    if (format == "int32")
+        return copyMappedIntegers<int32_t>(path, values, error);
+    if (format == "int64")
+        return copyMappedIntegers<int64_t>(path, values, error);
+
+    error = "unknown format " + format + " (text, int32 or int64)";
+    return false;
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+    Work-stealing task pool:
+    Runs a root task and all the tasks it spawns (recursively) on a fixed
+    number of threads. Each thread has its own deque of tasks: it pushes the
+    tasks it spawns onto the back, and takes its next task from the back too
+    (the most recently spawned, whose data is still in its cache). A thread
+    whose deque is empty steals the oldest task from the front of another
+    thread's deque, which for divide and conquer algorithms is also the
+    largest piece of work left.
+
+    Usage:
+        WorkStealingPool pool(threadCount);
+        pool.run([&]() { ... pool.spawn(subtask); ... });  // returns once every task is done
+
+    Tasks that need the results of their subtasks (fork-join) can use
+    parallel_invoke instead of spawn.
+
+    (Compile with the -pthread flag when using the CLI.)
+
+    Time complexity:
+    O(W / T + D), where W is the total work of the tasks, D is the length of
+    the longest chain of tasks that spawn each other, and T is the number of
+    threads
+
+    Space complexity:
+    O(T + S), where T is the number of threads and S is the number of tasks
+    waiting to be run at once
+*/
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+unsigned int hardwareThreadCount() {
+    const unsigned int hardwareThreads = thread::hardware_concurrency();
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+class WorkStealingPool {
+private:
+    struct TaskDeque {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    unsigned int threadCount;
+    vector<unique_ptr<TaskDeque>> deques;
+    atomic<size_t> pendingTasks;    // spawned, but not yet finished
+
+    // index of the deque of the calling thread, while it is running tasks of this pool
+    static size_t &current_worker() {
+        static thread_local size_t workerIndex = 0;
+        return workerIndex;
+    }
+
+    bool pop_own(const size_t worker, function<void()>& task) {
+        TaskDeque& own = *deques[worker];
+        lock_guard<mutex> guard(own.lock);
+        if (own.tasks.empty())
+            return false;
+
+        task = move(own.tasks.back());
+        own.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(const size_t thief, function<void()>& task) {
+        for (size_t offset = 1; offset < threadCount; offset++) {
+            TaskDeque& victim = *deques[(thief + offset) % threadCount];
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.tasks.empty())
+                continue;
+
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    // runs the calling thread's next task, or a stolen one; returns false if there was none
+    bool run_one_task(const size_t worker) {
+        function<void()> task;
+        if (!pop_own(worker, task) and !steal(worker, task))
+            return false;
+
+        task();
+        pendingTasks--;
+        return true;
+    }
+
+    void work(const size_t worker) {
+        current_worker() = worker;
+
+        while (pendingTasks.load() > 0)
+            if (!run_one_task(worker))
+                this_thread::yield();
+    }
+
+public:
+    explicit WorkStealingPool(const unsigned int threadCount = hardwareThreadCount())
+        : threadCount(threadCount > 0 ? threadCount : 1), pendingTasks(0) {
+        for (unsigned int i = 0; i < this->threadCount; i++)
+            deques.emplace_back(new TaskDeque());
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned int size() const { return threadCount; }
+
+    // queues a task on the calling thread's deque (to be called from a running task)
+    void spawn(function<void()> task) {
+        pendingTasks++;
+
+        TaskDeque& own = *deques[current_worker()];
+        lock_guard<mutex> guard(own.lock);
+        own.tasks.push_back(move(task));
+    }
+
+    /*
+        Runs both functions, possibly in parallel (to be called from a running
+        task), and returns once both are done. The second one is spawned, and
+        while waiting for it, the calling thread runs other tasks instead of
+        blocking.
+    */
+    void parallel_invoke(const function<void()>& first, const function<void()>& second) {
+        atomic<bool> isSecondDone(false);
+        spawn([&second, &isSecondDone]() {
+            second();
+            isSecondDone = true;
+        });
+
+        first();
+
+        while (!isSecondDone.load())
+            if (!run_one_task(current_worker()))
+                this_thread::yield();
+    }
+
+    // runs the root task, and everything it spawns, on all the threads; returns when they are all done
+    void run(function<void()> root) {
+        current_worker() = 0;
+        spawn(move(root));
+
+        vector<thread> workers;
+        for (unsigned int worker = 1; worker < threadCount; worker++)
+            workers.emplace_back(&WorkStealingPool::work, this, worker);
+        work(0);    // the calling thread works too
+
+        for (thread& workerThread : workers)
+            workerThread.join();
+    }
+};
+
+#endif